@@ -0,0 +1,258 @@
+#include "BUIEasing.h"
+
+// Vector versions of the functions in BUIEasing.h. Each kernel takes the normalized time T (time / duration)
+// along with the raw time, duration and parameter, and mirrors the scalar branches with VectorSelect.
+namespace BUIEasingKernels
+{
+	typedef VectorRegister4Float FVec;
+
+	static const float TwoPi = 2.0f * PI;
+
+	FORCEINLINE FVec Splat( float Value )
+	{
+		return VectorSetFloat1( Value );
+	}
+
+	FORCEINLINE FVec Square( const FVec& X )
+	{
+		return VectorMultiply( X, X );
+	}
+
+	FORCEINLINE FVec Cube( const FVec& X )
+	{
+		return VectorMultiply( Square( X ), X );
+	}
+
+	FORCEINLINE FVec Pow4( const FVec& X )
+	{
+		return Square( Square( X ) );
+	}
+
+	FORCEINLINE FVec Pow5( const FVec& X )
+	{
+		return VectorMultiply( Pow4( X ), X );
+	}
+
+	FORCEINLINE FVec SafeSqrt( const FVec& X )
+	{
+		// Only the lanes that get selected away can go negative
+		return VectorSqrt( VectorMax( X, VectorZeroFloat() ) );
+	}
+
+	// Amplitude and phase shift shared by the elastic functions, for a period of 1
+	FORCEINLINE void ElasticShape( const FVec& Param, FVec& OutAmplitude, FVec& OutShift )
+	{
+		const FVec One = VectorOneFloat();
+		const FVec IsSmall = VectorCompareLT( Param, One );
+		OutAmplitude = VectorSelect( IsSmall, One, Param );
+		OutShift = VectorSelect( IsSmall, Splat( 0.25f ), VectorMultiply( Splat( 1.0f / TwoPi ), VectorASin( VectorDivide( One, OutAmplitude ) ) ) );
+	}
+
+	FORCEINLINE FVec ElasticWave( const FVec& Amplitude, const FVec& Exponent, const FVec& Phase )
+	{
+		return VectorMultiply( VectorMultiply( Amplitude, VectorExp2( Exponent ) ), VectorSin( VectorMultiply( Phase, Splat( TwoPi ) ) ) );
+	}
+
+	// Runs Kernel over every full group of four and returns how many samples were processed
+	template<typename KernelType>
+	FORCEINLINE int32 Run( const KernelType& Kernel, const float* Times, const float* Durations, const float* Params, float* OutValues, int32 Num )
+	{
+		const FVec DefaultParam = Splat( FBUIEasing::DefaultParam );
+		int32 i = 0;
+		for ( ; i + 4 <= Num; i += 4 )
+		{
+			const FVec Time = VectorLoad( Times + i );
+			const FVec Duration = VectorLoad( Durations + i );
+			const FVec Param = Params ? VectorLoad( Params + i ) : DefaultParam;
+			VectorStore( Kernel( VectorDivide( Time, Duration ), Time, Duration, Param ), OutValues + i );
+		}
+		return i;
+	}
+}
+
+void FBUIEasing::EaseBatch( EBUIEasingType Type, const float* Times, const float* Durations, const float* Params, float* OutValues, int32 Num )
+{
+	using namespace BUIEasingKernels;
+
+	const FVec Zero = VectorZeroFloat();
+	const FVec One = VectorOneFloat();
+	const FVec Half = Splat( 0.5f );
+	const FVec Two = Splat( 2.0f );
+
+	#define BUI_KERNEL( ... ) Run( [ & ]( const FVec& T, const FVec& Time, const FVec& Duration, const FVec& Param ) -> FVec { __VA_ARGS__ }, Times, Durations, Params, OutValues, Num )
+
+	int32 NumDone = 0;
+	switch ( Type )
+	{
+		case EBUIEasingType::Linear:
+			NumDone = BUI_KERNEL( return T; );
+			break;
+		case EBUIEasingType::Smoothstep:
+			NumDone = BUI_KERNEL(
+				const FVec X = VectorMin( VectorMax( T, Zero ), One );
+				return VectorMultiply( Square( X ), VectorSubtract( Splat( 3.0f ), VectorMultiply( Two, X ) ) ); );
+			break;
+
+		case EBUIEasingType::InSine:
+			NumDone = BUI_KERNEL( return VectorSubtract( One, VectorCos( VectorMultiply( T, Splat( HALF_PI ) ) ) ); );
+			break;
+		case EBUIEasingType::OutSine:
+			NumDone = BUI_KERNEL( return VectorSin( VectorMultiply( T, Splat( HALF_PI ) ) ); );
+			break;
+		case EBUIEasingType::InOutSine:
+			NumDone = BUI_KERNEL( return VectorMultiply( Half, VectorSubtract( One, VectorCos( VectorMultiply( T, Splat( PI ) ) ) ) ); );
+			break;
+
+		case EBUIEasingType::InQuad:
+			NumDone = BUI_KERNEL( return Square( T ); );
+			break;
+		case EBUIEasingType::OutQuad:
+			NumDone = BUI_KERNEL( return VectorMultiply( T, VectorSubtract( Two, T ) ); );
+			break;
+		case EBUIEasingType::InOutQuad:
+			NumDone = BUI_KERNEL(
+				const FVec U = VectorMultiply( T, Two );
+				const FVec V = VectorSubtract( U, One );
+				const FVec Low = VectorMultiply( Half, Square( U ) );
+				const FVec High = VectorMultiply( Splat( -0.5f ), VectorSubtract( VectorMultiply( V, VectorSubtract( V, Two ) ), One ) );
+				return VectorSelect( VectorCompareLT( U, One ), Low, High ); );
+			break;
+
+		case EBUIEasingType::InCubic:
+			NumDone = BUI_KERNEL( return Cube( T ); );
+			break;
+		case EBUIEasingType::OutCubic:
+			NumDone = BUI_KERNEL( return VectorAdd( Cube( VectorSubtract( T, One ) ), One ); );
+			break;
+		case EBUIEasingType::InOutCubic:
+			NumDone = BUI_KERNEL(
+				const FVec U = VectorMultiply( T, Two );
+				const FVec V = VectorSubtract( U, Two );
+				const FVec Low = VectorMultiply( Half, Cube( U ) );
+				const FVec High = VectorMultiply( Half, VectorAdd( Cube( V ), Two ) );
+				return VectorSelect( VectorCompareLT( U, One ), Low, High ); );
+			break;
+
+		case EBUIEasingType::InQuart:
+			NumDone = BUI_KERNEL( return Pow4( T ); );
+			break;
+		case EBUIEasingType::OutQuart:
+			NumDone = BUI_KERNEL( return VectorSubtract( One, Pow4( VectorSubtract( T, One ) ) ); );
+			break;
+		case EBUIEasingType::InOutQuart:
+			NumDone = BUI_KERNEL(
+				const FVec U = VectorMultiply( T, Two );
+				const FVec V = VectorSubtract( U, Two );
+				const FVec Low = VectorMultiply( Half, Pow4( U ) );
+				const FVec High = VectorMultiply( Splat( -0.5f ), VectorSubtract( Pow4( V ), Two ) );
+				return VectorSelect( VectorCompareLT( U, One ), Low, High ); );
+			break;
+
+		case EBUIEasingType::InQuint:
+			NumDone = BUI_KERNEL( return Pow5( T ); );
+			break;
+		case EBUIEasingType::OutQuint:
+			NumDone = BUI_KERNEL( return VectorAdd( Pow5( VectorSubtract( T, One ) ), One ); );
+			break;
+		case EBUIEasingType::InOutQuint:
+			NumDone = BUI_KERNEL(
+				const FVec U = VectorMultiply( T, Two );
+				const FVec V = VectorSubtract( U, Two );
+				const FVec Low = VectorMultiply( Half, Pow5( U ) );
+				const FVec High = VectorMultiply( Half, VectorAdd( Pow5( V ), Two ) );
+				return VectorSelect( VectorCompareLT( U, One ), Low, High ); );
+			break;
+
+		case EBUIEasingType::InExpo:
+			NumDone = BUI_KERNEL(
+				const FVec Value = VectorExp2( VectorMultiply( Splat( 10.0f ), VectorSubtract( T, One ) ) );
+				return VectorSelect( VectorCompareEQ( Time, Zero ), Zero, Value ); );
+			break;
+		case EBUIEasingType::OutExpo:
+			NumDone = BUI_KERNEL(
+				const FVec Value = VectorSubtract( One, VectorExp2( VectorMultiply( Splat( -10.0f ), T ) ) );
+				return VectorSelect( VectorCompareEQ( Time, Duration ), One, Value ); );
+			break;
+		case EBUIEasingType::InOutExpo:
+			NumDone = BUI_KERNEL(
+				const FVec V = VectorSubtract( T, One );
+				const FVec Low = VectorMultiply( Half, VectorExp2( VectorMultiply( Splat( 10.0f ), V ) ) );
+				const FVec High = VectorMultiply( Half, VectorSubtract( Two, VectorExp2( VectorMultiply( Splat( -10.0f ), V ) ) ) );
+				const FVec Value = VectorSelect( VectorCompareLT( VectorMultiply( T, Half ), One ), Low, High );
+				return VectorSelect( VectorCompareEQ( Time, Zero ), Zero, VectorSelect( VectorCompareEQ( Time, Duration ), One, Value ) ); );
+			break;
+
+		case EBUIEasingType::InCirc:
+			NumDone = BUI_KERNEL( return VectorSubtract( One, SafeSqrt( VectorSubtract( One, Square( T ) ) ) ); );
+			break;
+		case EBUIEasingType::OutCirc:
+			NumDone = BUI_KERNEL( return SafeSqrt( VectorSubtract( One, Square( VectorSubtract( T, One ) ) ) ); );
+			break;
+		case EBUIEasingType::InOutCirc:
+			NumDone = BUI_KERNEL(
+				const FVec U = VectorMultiply( T, Two );
+				const FVec V = VectorSubtract( U, Two );
+				const FVec Low = VectorMultiply( Half, VectorSubtract( One, SafeSqrt( VectorSubtract( One, Square( U ) ) ) ) );
+				const FVec High = VectorMultiply( Half, VectorAdd( SafeSqrt( VectorSubtract( One, Square( V ) ) ), One ) );
+				return VectorSelect( VectorCompareLT( U, One ), Low, High ); );
+			break;
+
+		case EBUIEasingType::InElastic:
+			NumDone = BUI_KERNEL(
+				FVec Amplitude;
+				FVec Shift;
+				ElasticShape( Param, Amplitude, Shift );
+				const FVec V = VectorSubtract( T, One );
+				const FVec Value = VectorNegate( ElasticWave( Amplitude, VectorMultiply( Splat( 10.0f ), V ), VectorSubtract( VectorMultiply( V, Duration ), Shift ) ) );
+				return VectorSelect( VectorCompareEQ( Time, Zero ), Zero, VectorSelect( VectorCompareEQ( T, One ), One, Value ) ); );
+			break;
+		case EBUIEasingType::OutElastic:
+			NumDone = BUI_KERNEL(
+				FVec Amplitude;
+				FVec Shift;
+				ElasticShape( Param, Amplitude, Shift );
+				const FVec Value = VectorAdd( ElasticWave( Amplitude, VectorMultiply( Splat( -10.0f ), T ), VectorSubtract( VectorMultiply( T, Duration ), Shift ) ), One );
+				return VectorSelect( VectorCompareEQ( Time, Zero ), Zero, VectorSelect( VectorCompareEQ( T, One ), One, Value ) ); );
+			break;
+		case EBUIEasingType::InOutElastic:
+			NumDone = BUI_KERNEL(
+				FVec Amplitude;
+				FVec Shift;
+				ElasticShape( Param, Amplitude, Shift );
+				const FVec U = VectorDivide( Time, VectorMultiply( Duration, Half ) );
+				const FVec V = VectorSubtract( U, One );
+				const FVec Phase = VectorSubtract( VectorMultiply( V, Duration ), Shift );
+				const FVec Low = VectorMultiply( Splat( -0.5f ), ElasticWave( Amplitude, VectorMultiply( Splat( 10.0f ), V ), Phase ) );
+				const FVec High = VectorAdd( VectorMultiply( Half, ElasticWave( Amplitude, VectorMultiply( Splat( -10.0f ), V ), Phase ) ), One );
+				const FVec Value = VectorSelect( VectorCompareLT( V, One ), Low, High );
+				return VectorSelect( VectorCompareEQ( Time, Zero ), Zero, VectorSelect( VectorCompareEQ( U, Two ), One, Value ) ); );
+			break;
+
+		case EBUIEasingType::InBack:
+			NumDone = BUI_KERNEL(
+				return VectorMultiply( Square( T ), VectorSubtract( VectorMultiply( VectorAdd( Param, One ), T ), Param ) ); );
+			break;
+		case EBUIEasingType::OutBack:
+			NumDone = BUI_KERNEL(
+				const FVec V = VectorSubtract( T, One );
+				return VectorAdd( VectorMultiply( Square( V ), VectorAdd( VectorMultiply( VectorAdd( Param, One ), V ), Param ) ), One ); );
+			break;
+		case EBUIEasingType::InOutBack:
+			NumDone = BUI_KERNEL(
+				const FVec S = VectorMultiply( Param, Splat( 1.525f ) );
+				const FVec SPlusOne = VectorAdd( S, One );
+				const FVec U = VectorMultiply( T, Two );
+				const FVec V = VectorSubtract( U, Two );
+				const FVec Low = VectorMultiply( Half, VectorMultiply( Square( U ), VectorSubtract( VectorMultiply( SPlusOne, U ), S ) ) );
+				const FVec High = VectorMultiply( Half, VectorAdd( VectorMultiply( Square( V ), VectorAdd( VectorMultiply( SPlusOne, V ), S ) ), Two ) );
+				return VectorSelect( VectorCompareLT( U, One ), Low, High ); );
+			break;
+	}
+
+	#undef BUI_KERNEL
+
+	for ( int32 i = NumDone; i < Num; ++i )
+	{
+		OutValues[ i ] = Ease( Type, Times[ i ], Durations[ i ], Params ? Params[ i ] : DefaultParam );
+	}
+}
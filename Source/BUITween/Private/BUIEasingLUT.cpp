@@ -0,0 +1,228 @@
+#include "BUIEasingLUT.h"
+#include "BUITweenInstance.h"
+
+// Tables are never grown past this, a curve that still misses the max error stays analytic
+static const int32 MaxTableResolution = 16384;
+
+// The scalar functions special-case time == 0 and time == duration, and for expo and elastic that's a
+// small jump from the curve around it. Tables hold the continuous curve and Ease() handles the ends.
+static const float EndpointNudge = 1e-6f;
+
+FBUIEasingLUT& FBUIEasingLUT::Get()
+{
+	static FBUIEasingLUT Instance;
+	return Instance;
+}
+
+
+void FBUIEasingLUT::Configure( bool bInIsEnabled, int32 InResolution, float InMaxError, int32 InMaxKeyedTables )
+{
+	Empty();
+	bIsEnabled = bInIsEnabled;
+	Resolution = FMath::Clamp( InResolution, 16, MaxTableResolution );
+	MaxError = FMath::Max( InMaxError, 0.0f );
+	MaxKeyedTables = FMath::Max( InMaxKeyedTables, 0 );
+}
+
+
+void FBUIEasingLUT::BuildStaticTables()
+{
+	for ( int32 TypeIndex = 0; TypeIndex < FBUIEasing::NumTypes; ++TypeIndex )
+	{
+		const EBUIEasingType Type = static_cast<EBUIEasingType>( TypeIndex );
+		if ( UsesTable( Type ) )
+		{
+			// Keyed types get their most likely table, the one for the default param
+			FindOrBuild( Type, 1.0f, FBUIEasing::DefaultParam );
+		}
+	}
+}
+
+
+void FBUIEasingLUT::Empty()
+{
+	for ( int32 TypeIndex = 0; TypeIndex < FBUIEasing::NumTypes; ++TypeIndex )
+	{
+		StaticTables[ TypeIndex ].Reset();
+		bStaticTableBuilt[ TypeIndex ] = false;
+	}
+	KeyedTables.Empty();
+	bHasWarnedFull = false;
+	++Generation;
+}
+
+
+bool FBUIEasingLUT::UsesTable( EBUIEasingType Type )
+{
+	switch ( Type )
+	{
+		case EBUIEasingType::InSine:
+		case EBUIEasingType::OutSine:
+		case EBUIEasingType::InOutSine:
+		case EBUIEasingType::InExpo:
+		case EBUIEasingType::OutExpo:
+		case EBUIEasingType::InOutExpo:
+		case EBUIEasingType::InElastic:
+		case EBUIEasingType::OutElastic:
+		case EBUIEasingType::InOutElastic:
+		case EBUIEasingType::InBack:
+		case EBUIEasingType::OutBack:
+		case EBUIEasingType::InOutBack:
+			return true;
+		default:
+			return false;
+	}
+}
+
+
+bool FBUIEasingLUT::IsKeyedOnDuration( EBUIEasingType Type )
+{
+	// The elastic period is in seconds rather than normalized, so the curve's shape changes with duration
+	return Type == EBUIEasingType::InElastic || Type == EBUIEasingType::OutElastic || Type == EBUIEasingType::InOutElastic;
+}
+
+
+bool FBUIEasingLUT::IsKeyedOnParam( EBUIEasingType Type )
+{
+	return IsKeyedOnDuration( Type ) || Type == EBUIEasingType::InBack || Type == EBUIEasingType::OutBack || Type == EBUIEasingType::InOutBack;
+}
+
+
+const FBUIEasingTable* FBUIEasingLUT::FindOrBuild( EBUIEasingType Type, float Duration, float Param )
+{
+	check( IsInGameThread() );
+
+	if ( !UsesTable( Type ) )
+	{
+		return nullptr;
+	}
+
+	const int32 TypeIndex = static_cast<int32>( Type );
+	if ( !IsKeyedOnParam( Type ) )
+	{
+		if ( !bStaticTableBuilt[ TypeIndex ] )
+		{
+			StaticTables[ TypeIndex ] = Build( Type, 1.0f, Param );
+			bStaticTableBuilt[ TypeIndex ] = true;
+		}
+		return StaticTables[ TypeIndex ].Get();
+	}
+
+	FKey Key;
+	if ( !MakeKey( Type, Duration, Param, Key ) )
+	{
+		return nullptr;
+	}
+	if ( const TUniquePtr<FBUIEasingTable>* pExisting = KeyedTables.Find( Key ) )
+	{
+		return pExisting->Get();
+	}
+
+	if ( KeyedTables.Num() >= MaxKeyedTables )
+	{
+		UE_CLOG( !bHasWarnedFull, LogBUITween, Warning, TEXT( "All %d keyed easing tables are in use, new elastic and back curves use the analytic easing" ), MaxKeyedTables );
+		bHasWarnedFull = true;
+		return nullptr;
+	}
+
+	return KeyedTables.Add( Key, Build( Type, Key.Duration, Key.Param ) ).Get();
+}
+
+
+const FBUIEasingTable* FBUIEasingLUT::Find( EBUIEasingType Type, float Duration, float Param ) const
+{
+	if ( !UsesTable( Type ) )
+	{
+		return nullptr;
+	}
+	if ( !IsKeyedOnParam( Type ) )
+	{
+		return StaticTables[ static_cast<int32>( Type ) ].Get();
+	}
+
+	FKey Key;
+	const TUniquePtr<FBUIEasingTable>* pExisting = MakeKey( Type, Duration, Param, Key ) ? KeyedTables.Find( Key ) : nullptr;
+	return pExisting ? pExisting->Get() : nullptr;
+}
+
+
+bool FBUIEasingLUT::MakeKey( EBUIEasingType Type, float Duration, float Param, FKey& OutKey )
+{
+	OutKey = { Type, 1.0f, Param };
+	if ( IsKeyedOnDuration( Type ) )
+	{
+		// The table is built for the grid duration, so it has to match closely or the phase drifts
+		OutKey.Duration = FMath::RoundToFloat( Duration / DurationQuantum ) * DurationQuantum;
+		return FMath::IsNearlyEqual( Duration, OutKey.Duration, 1e-5f );
+	}
+	return true;
+}
+
+
+TUniquePtr<FBUIEasingTable> FBUIEasingLUT::Build( EBUIEasingType Type, float Duration, float Param ) const
+{
+	auto Analytic = [ Type, Duration, Param ]( float T )
+	{
+		T = FMath::Clamp( T, EndpointNudge, 1.0f - EndpointNudge );
+		return FBUIEasing::Ease( Type, T * Duration, Duration, Param );
+	};
+
+	for ( int32 NumIntervals = Resolution; NumIntervals <= MaxTableResolution; NumIntervals *= 2 )
+	{
+		TUniquePtr<FBUIEasingTable> Table = MakeUnique<FBUIEasingTable>();
+		Table->Values.SetNumUninitialized( NumIntervals + 1 );
+		for ( int32 i = 0; i <= NumIntervals; ++i )
+		{
+			Table->Values[ i ] = Analytic( static_cast<float>( i ) / NumIntervals );
+		}
+
+		// Linear interpolation error peaks inside an interval, checking a few points per interval is enough
+		for ( int32 i = 0; i < NumIntervals && Table->MaxError <= MaxError; ++i )
+		{
+			for ( const float Fraction : { 0.25f, 0.5f, 0.75f } )
+			{
+				const float T = ( i + Fraction ) / NumIntervals;
+				Table->MaxError = FMath::Max( Table->MaxError, FMath::Abs( Table->Sample( T ) - Analytic( T ) ) );
+			}
+		}
+
+		if ( Table->MaxError <= MaxError )
+		{
+			return Table;
+		}
+	}
+
+	UE_LOG( LogBUITween, Verbose, TEXT( "Easing %d (duration %g, param %g) doesn't fit in a %d entry table within %g, using the analytic curve" ),
+		static_cast<int32>( Type ), Duration, Param, MaxTableResolution, MaxError );
+	return nullptr;
+}
+
+
+int32 FBUIEasingLUT::NumTables() const
+{
+	int32 Num = 0;
+	for ( const TUniquePtr<FBUIEasingTable>& Table : StaticTables )
+	{
+		Num += Table.IsValid() ? 1 : 0;
+	}
+	for ( const TPair< FKey, TUniquePtr<FBUIEasingTable> >& Pair : KeyedTables )
+	{
+		Num += Pair.Value.IsValid() ? 1 : 0;
+	}
+	return Num;
+}
+
+
+float FBUIEasingLUT::GetWorstError() const
+{
+	float WorstError = 0;
+	for ( const TUniquePtr<FBUIEasingTable>& Table : StaticTables )
+	{
+		WorstError = Table.IsValid() ? FMath::Max( WorstError, Table->MaxError ) : WorstError;
+	}
+	for ( const TPair< FKey, TUniquePtr<FBUIEasingTable> >& Pair : KeyedTables )
+	{
+		WorstError = Pair.Value.IsValid() ? FMath::Max( WorstError, Pair.Value->MaxError ) : WorstError;
+	}
+	return WorstError;
+}
@@ -1,21 +1,34 @@
 #include "BUITween.h"
+#include "BUITweenSubsystem.h"
+#include "BUITweenSettings.h"
+#include "BUIEasingLUT.h"
+#include "HAL/IConsoleManager.h"
+#include "BUITweenStats.h"
 
-TArray< FBUITweenInstance > UBUITween::ActiveInstances = TArray< FBUITweenInstance >();
-TArray< FBUITweenInstance > UBUITween::InstancesToAdd = TArray< FBUITweenInstance >();
+FBUITweenStorage UBUITween::Storage;
 bool UBUITween::bIsInitialized = false;
 
 void UBUITween::Startup()
 {
 	bIsInitialized = true;
-	ActiveInstances.Empty();
-	InstancesToAdd.Empty();
+	Storage.Empty();
+
+	const UBUITweenSettings* Settings = GetDefault<UBUITweenSettings>();
+	Storage.Reserve( Settings->ReservedTweenCapacity );
+
+	FBUIEasingLUT& EasingLUT = FBUIEasingLUT::Get();
+	EasingLUT.Configure( Settings->bUseEasingLUT, Settings->EasingLUTResolution, Settings->EasingLUTMaxError, Settings->MaxKeyedEasingLUTs );
+	if ( Settings->bUseEasingLUT && Settings->bBuildEasingLUTAtStartup )
+	{
+		EasingLUT.BuildStaticTables();
+	}
 }
 
 
 void UBUITween::Shutdown()
 {
-	ActiveInstances.Empty();
-	InstancesToAdd.Empty();
+	Storage.Empty();
+	FBUIEasingLUT::Get().Empty();
 	bIsInitialized = false;
 }
 
@@ -28,69 +41,240 @@ FBUITweenInstance& UBUITween::Create( UWidget* pInWidget, float InDuration, floa
 		Clear( pInWidget );
 	}
 
-	FBUITweenInstance Instance( pInWidget, InDuration, InDelay );
+	return GetStorage( pInWidget ).Create( pInWidget, InDuration, InDelay );
+}
+
 
-	InstancesToAdd.Add( Instance );
+FBUITweenInstance& UBUITween::CreateInGroup( FName InGroup, UWidget* pInWidget, float InDuration, float InDelay, bool bIsAdditive )
+{
+	if ( !bIsAdditive )
+	{
+		Clear( pInWidget );
+	}
 
-	return InstancesToAdd.Last();
+	return GetStorage( pInWidget, InGroup ).Create( pInWidget, InDuration, InDelay );
+}
+
+
+FBUITweenInstance& UBUITween::CreateSlate( const TSharedRef<SWidget>& InWidget, float InDuration, float InDelay, bool bIsAdditive )
+{
+	if ( !bIsAdditive )
+	{
+		Clear( InWidget );
+	}
+
+	return Storage.CreateSlate( InWidget, InDuration, InDelay );
+}
+
+
+FBUITweenSequence& UBUITween::CreateSequence( float InDelay, const UObject* WorldContextObject )
+{
+	return GetStorage( WorldContextObject ).CreateSequence( InDelay );
+}
+
+
+FBUITweenInstance& UBUITween::CreateStaggered( TArrayView<UWidget* const> InWidgets, float InDuration, float InStaggerInterval, float InDelay, bool bIsAdditive )
+{
+	if ( !bIsAdditive )
+	{
+		for ( UWidget* pWidget : InWidgets )
+		{
+			Clear( pWidget );
+		}
+	}
+
+	return GetStorage( InWidgets.Num() > 0 ? InWidgets[ 0 ] : nullptr ).CreateStaggered( InWidgets, InDuration, InStaggerInterval, InDelay );
 }
 
 
 int32 UBUITween::Clear( UWidget* pInWidget )
 {
-	int32 NumRemoved = 0;
+	UBUITweenSubsystem* Subsystem = UBUITweenSubsystem::Get( pInWidget );
+	return Subsystem ? Subsystem->Clear( pInWidget ) : Storage.Clear( pInWidget );
+}
+
+
+int32 UBUITween::Clear( const TSharedRef<SWidget>& InWidget )
+{
+	return Storage.Clear( InWidget );
+}
+
+
+FBUITweenStorage& UBUITween::GetStorage( const UObject* WorldContextObject, FName InGroup )
+{
+	UBUITweenSubsystem* Subsystem = UBUITweenSubsystem::Get( WorldContextObject );
+	return Subsystem ? Subsystem->GetStorage( InGroup ) : Storage;
+}
 
-	auto DoesTweenMatchWidgetFn = [pInWidget](const FBUITweenInstance& CurTweenInstance) -> bool {
-		return ( CurTweenInstance.GetWidget().IsValid() && CurTweenInstance.GetWidget() == pInWidget );
-	};
 
-	NumRemoved += ActiveInstances.RemoveAll(DoesTweenMatchWidgetFn);
-	NumRemoved += InstancesToAdd.RemoveAll(DoesTweenMatchWidgetFn);
+void UBUITween::ConfigureGroup( const UObject* WorldContextObject, FName InGroup, const FBUITweenGroupSettings& InSettings )
+{
+	if ( UBUITweenSubsystem* Subsystem = UBUITweenSubsystem::Get( WorldContextObject ) )
+	{
+		Subsystem->ConfigureGroup( InGroup, InSettings );
+	}
+}
+
+
+void UBUITween::SetGroupPaused( const UObject* WorldContextObject, FName InGroup, bool bInIsPaused )
+{
+	if ( UBUITweenSubsystem* Subsystem = UBUITweenSubsystem::Get( WorldContextObject ) )
+	{
+		Subsystem->SetGroupPaused( InGroup, bInIsPaused );
+	}
+}
+
 
-	return NumRemoved;
+void UBUITween::SetGroupTimeScale( const UObject* WorldContextObject, FName InGroup, float InTimeScale )
+{
+	if ( UBUITweenSubsystem* Subsystem = UBUITweenSubsystem::Get( WorldContextObject ) )
+	{
+		Subsystem->SetGroupTimeScale( InGroup, InTimeScale );
+	}
 }
 
 
 void UBUITween::Update( float DeltaTime )
 {
-	// Reverse it so we can remove
-	for ( int32 i = ActiveInstances.Num()-1; i >= 0; --i )
 	{
-		FBUITweenInstance& Inst = ActiveInstances[ i ];
-		Inst.Update( DeltaTime );
-		if ( Inst.IsComplete() )
-		{
-			FBUITweenInstance CompleteInst = Inst;
-			ActiveInstances.RemoveAtSwap( i );
+		BUITWEEN_SCOPE( Update );
+		Storage.Update( DeltaTime );
+	}
 
-			// We do this here outside of the instance update and after removing from active instances because we
-			// don't know if the callback in the cleanup is going to trigger adding more events
-			CompleteInst.DoCompleteCleanup();
-		}
+	// The worlds tick their own storages, the stats cover all of them
+	int32 NumActive = 0;
+	int32 NumPending = 0;
+	SIZE_T HeaderMemory = 0;
+	SIZE_T ChannelMemory = 0;
+	SIZE_T InstanceMemory = 0;
+	int64 NumWrites = 0;
+	for ( const TPair< uint32, FBUITweenStorage* >& Pair : FBUITweenStorage::GetAll() )
+	{
+		const FBUITweenStorage& Each = *Pair.Value;
+		NumActive += Each.Num();
+		NumPending += Each.NumPending();
+		HeaderMemory += Each.GetHeaderAllocatedSize();
+		ChannelMemory += Each.GetChannelAllocatedSize();
+		InstanceMemory += Each.GetInstanceAllocatedSize();
+		NumWrites += Each.GetApplyStats().NumWrites;
 	}
 
-	ActiveInstances.Append(MoveTemp(InstancesToAdd));
-	InstancesToAdd.Empty();
+	SET_DWORD_STAT( STAT_BUITween_NumActive, NumActive );
+	SET_DWORD_STAT( STAT_BUITween_NumPending, NumPending );
+	SET_MEMORY_STAT( STAT_BUITween_HeaderMemory, HeaderMemory );
+	SET_MEMORY_STAT( STAT_BUITween_ChannelMemory, ChannelMemory );
+	SET_MEMORY_STAT( STAT_BUITween_InstanceMemory, InstanceMemory );
+
+	TRACE_COUNTER_SET( BUITween_NumActive, NumActive );
+	TRACE_COUNTER_SET( BUITween_NumWrites, NumWrites );
 }
 
 
 bool UBUITween::GetIsTweening( UWidget* pInWidget )
 {
-	for ( int32 i = 0; i < ActiveInstances.Num(); ++i )
+	UBUITweenSubsystem* Subsystem = UBUITweenSubsystem::Get( pInWidget );
+	return Subsystem ? Subsystem->Contains( pInWidget ) : Storage.Contains( pInWidget );
+}
+
+
+void UBUITween::CompleteAll()
+{
+	// Complete callbacks can create or tear down storages, so walk a copy of the ids
+	TArray< uint32 > StorageIds;
+	FBUITweenStorage::GetAll().GenerateKeyArray( StorageIds );
+	for ( uint32 StorageId : StorageIds )
 	{
-		if ( ActiveInstances[ i ].GetWidget() == pInWidget )
+		if ( FBUITweenStorage* Found = FBUITweenStorage::FindById( StorageId ) )
 		{
-			return true;
+			Found->CompleteAll();
 		}
 	}
-	return false;
 }
 
 
-void UBUITween::CompleteAll()
+FBUITweenInstance* UBUITween::Find( const FBUITweenHandle& Handle )
 {
-	// Very hacky way to make sure all Tweens complete immediately.
-	// First Update clears ActiveTweens, second clears "InstancesToAdd".
-	Update( 100000 );
-	Update( 100000 );
+	FBUITweenStorage* Found = FBUITweenStorage::FindById( Handle.StorageId );
+	return Found ? Found->Find( Handle ) : nullptr;
 }
+
+
+bool UBUITween::GetIsTweening( const FBUITweenHandle& Handle )
+{
+	FBUITweenStorage* Found = FBUITweenStorage::FindById( Handle.StorageId );
+	return Found && Found->IsTweening( Handle );
+}
+
+
+bool UBUITween::Pause( const FBUITweenHandle& Handle )
+{
+	FBUITweenStorage* Found = FBUITweenStorage::FindById( Handle.StorageId );
+	return Found && Found->SetPaused( Handle, true );
+}
+
+
+bool UBUITween::Resume( const FBUITweenHandle& Handle )
+{
+	FBUITweenStorage* Found = FBUITweenStorage::FindById( Handle.StorageId );
+	return Found && Found->SetPaused( Handle, false );
+}
+
+
+FBUITweenRetarget UBUITween::Retarget( const FBUITweenHandle& Handle )
+{
+	return FBUITweenRetarget( FBUITweenStorage::FindById( Handle.StorageId ), Handle );
+}
+
+
+FBUITweenRetarget UBUITween::Retarget( UWidget* pInWidget )
+{
+	UBUITweenSubsystem* Subsystem = UBUITweenSubsystem::Get( pInWidget );
+	const FBUITweenHandle Handle = Subsystem ? Subsystem->FindHandle( pInWidget ) : Storage.FindHandle( pInWidget );
+	return FBUITweenRetarget( FBUITweenStorage::FindById( Handle.StorageId ), Handle );
+}
+
+
+bool UBUITween::Cancel( const FBUITweenHandle& Handle )
+{
+	FBUITweenStorage* Found = FBUITweenStorage::FindById( Handle.StorageId );
+	return Found && Found->Cancel( Handle );
+}
+
+
+FBUITweenApplyStats UBUITween::GetApplyStats()
+{
+	FBUITweenApplyStats Total;
+	for ( const TPair< uint32, FBUITweenStorage* >& Pair : FBUITweenStorage::GetAll() )
+	{
+		Total.NumRequested += Pair.Value->GetApplyStats().NumRequested;
+		Total.NumWrites += Pair.Value->GetApplyStats().NumWrites;
+		Total.NumCulled += Pair.Value->GetApplyStats().NumCulled;
+	}
+	return Total;
+}
+
+
+FBUITweenApplyStats UBUITween::GetTotalApplyStats()
+{
+	FBUITweenApplyStats Total;
+	for ( const TPair< uint32, FBUITweenStorage* >& Pair : FBUITweenStorage::GetAll() )
+	{
+		Total.NumRequested += Pair.Value->GetTotalApplyStats().NumRequested;
+		Total.NumWrites += Pair.Value->GetTotalApplyStats().NumWrites;
+	}
+	return Total;
+}
+
+
+static FAutoConsoleCommand BUITweenApplyStatsCommand(
+	TEXT( "BUITween.ApplyStats" ),
+	TEXT( "Logs how many widget writes the tween apply phase made and how many it avoided, last frame and since startup." ),
+	FConsoleCommandDelegate::CreateLambda( []()
+	{
+		const FBUITweenApplyStats Frame = UBUITween::GetApplyStats();
+		const FBUITweenApplyStats Total = UBUITween::GetTotalApplyStats();
+		UE_LOG( LogBUITween, Display, TEXT( "BUITween apply: last frame %lld writes, %lld avoided, %lld tweens culled. Total %lld writes, %lld avoided (%.1f%%)" ),
+			Frame.NumWrites, Frame.NumAvoided(), Frame.NumCulled, Total.NumWrites, Total.NumAvoided(),
+			Total.NumRequested > 0 ? 100.0 * Total.NumAvoided() / Total.NumRequested : 0.0 );
+	} )
+);
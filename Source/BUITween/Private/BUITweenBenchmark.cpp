@@ -0,0 +1,496 @@
+#include "BUITweenBenchmark.h"
+#include "BUITweenStorage.h"
+#include "BUIEasingLUT.h"
+#include "BUITweenSettings.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Components/Image.h"
+#include "UObject/Package.h"
+
+// Console commands for measuring the tween system on transient widgets. They run on their own
+// FBUITweenStorage so the tweens of the running game are left alone. Correctness is checked by the
+// BUITween automation tests, these only report throughput.
+// They also work headless, e.g. UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="BUITween.Benchmark.Update, Quit"
+
+namespace BUITweenBenchmark
+{
+	static int32 ParseIntArg( const TArray<FString>& Args, int32 Index, int32 Default )
+	{
+		return Args.IsValidIndex( Index ) ? FMath::Max( 1, FCString::Atoi( *Args[ Index ] ) ) : Default;
+	}
+
+	static volatile float Sink = 0;
+
+	static float ParseFloatArg( const TArray<FString>& Args, int32 Index, float Default )
+	{
+		return Args.IsValidIndex( Index ) ? FCString::Atof( *Args[ Index ] ) : Default;
+	}
+
+	static void CreateWidgets( int32 NumWidgets, TArray<UWidget*>& OutWidgets )
+	{
+		OutWidgets.Reserve( NumWidgets );
+		for ( int32 i = 0; i < NumWidgets; ++i )
+		{
+			OutWidgets.Add( NewObject<UImage>( GetTransientPackage() ) );
+		}
+	}
+
+	// Every widget restarts a non-additive tween every frame, like hover tweens on a list view
+	static void RunClear( const TArray<FString>& Args )
+	{
+		const int32 NumWidgets = ParseIntArg( Args, 0, 500 );
+		const int32 NumFrames = ParseIntArg( Args, 1, 60 );
+
+		TArray<UWidget*> Widgets;
+		CreateWidgets( NumWidgets, Widgets );
+
+		// What Create/Clear did before the widget index: RemoveAll over every instance
+		double LinearSeconds = 0;
+		{
+			TArray< FBUITweenInstance > Instances;
+			for ( int32 Frame = 0; Frame < NumFrames; ++Frame )
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				for ( UWidget* Widget : Widgets )
+				{
+					Instances.RemoveAll( [ Widget ]( const FBUITweenInstance& Instance )
+					{
+						return Instance.GetWidget().IsValid() && Instance.GetWidget() == Widget;
+					} );
+					Instances.Add( FBUITweenInstance( Widget, 1.0f ) );
+				}
+				LinearSeconds += FPlatformTime::Seconds() - StartTime;
+			}
+		}
+
+		double IndexedSeconds = 0;
+		{
+			FBUITweenStorage Storage;
+			for ( int32 Frame = 0; Frame < NumFrames; ++Frame )
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				for ( UWidget* Widget : Widgets )
+				{
+					Storage.Clear( Widget );
+					Storage.Create( Widget, 1.0f, 0.0f );
+				}
+				IndexedSeconds += FPlatformTime::Seconds() - StartTime;
+
+				// Moves the pending tweens into the headers so the next frame clears running ones
+				Storage.Update( 0.0f );
+			}
+		}
+
+		const double LinearMs = LinearSeconds * 1000.0 / NumFrames;
+		const double IndexedMs = IndexedSeconds * 1000.0 / NumFrames;
+		UE_LOG( LogBUITween, Display, TEXT( "BUITween clear benchmark: %d widgets, %d frames" ), NumWidgets, NumFrames );
+		UE_LOG( LogBUITween, Display, TEXT( "  linear scan: %.4f ms/frame" ), LinearMs );
+		UE_LOG( LogBUITween, Display, TEXT( "  widget index: %.4f ms/frame (%.4f ms/frame saved, %.1fx)" ),
+			IndexedMs, LinearMs - IndexedMs, IndexedMs > 0 ? LinearMs / IndexedMs : 0.0 );
+	}
+
+	FEasingSamples MakeEasingSamples( int32 NumSamples )
+	{
+		FRandomStream Random( 1234 );
+		FEasingSamples Samples;
+		Samples.Times.SetNumUninitialized( NumSamples );
+		Samples.Durations.SetNumUninitialized( NumSamples );
+		Samples.Params.SetNumUninitialized( NumSamples );
+		for ( int32 i = 0; i < NumSamples; ++i )
+		{
+			Samples.Durations[ i ] = Random.FRandRange( 0.1f, 2.0f );
+			const int32 Edge = i % 64;
+			Samples.Times[ i ] = Edge == 0 ? 0.0f : Edge == 1 ? Samples.Durations[ i ] : Random.FRandRange( 0.0f, Samples.Durations[ i ] );
+			Samples.Params[ i ] = ( i % 2 ) ? FBUIEasing::DefaultParam : Random.FRandRange( 0.0f, 3.0f );
+		}
+		return Samples;
+	}
+
+
+	float MeasureBatchError( EBUIEasingType Type, const FEasingSamples& Samples )
+	{
+		const int32 NumSamples = Samples.Times.Num();
+		TArray<float> BatchValues;
+		BatchValues.SetNumUninitialized( NumSamples );
+		FBUIEasing::EaseBatch( Type, Samples.Times.GetData(), Samples.Durations.GetData(), Samples.Params.GetData(), BatchValues.GetData(), NumSamples );
+
+		float MaxError = 0;
+		for ( int32 i = 0; i < NumSamples; ++i )
+		{
+			const float ScalarValue = FBUIEasing::Ease( Type, Samples.Times[ i ], Samples.Durations[ i ], Samples.Params[ i ] );
+			MaxError = FMath::Max( MaxError, FMath::Abs( ScalarValue - BatchValues[ i ] ) );
+		}
+		return MaxError;
+	}
+
+
+	// The params and durations a UI typically uses
+	static const float TestParams[] = { FBUIEasing::DefaultParam, 0.5f, 1.0f, 1.70158f, 3.0f };
+	static const float TestDurations[] = { 0.15f, 0.3f, 0.5f, 1.0f, 2.0f };
+
+	float MeasureLUTError( FBUIEasingLUT& EasingLUT, EBUIEasingType Type, int32 NumSamples, int32& OutNumAnalytic )
+	{
+		const int32 NumParams = FBUIEasingLUT::IsKeyedOnParam( Type ) ? UE_ARRAY_COUNT( TestParams ) : 1;
+		float WorstError = 0;
+		OutNumAnalytic = 0;
+		for ( int32 ParamIndex = 0; ParamIndex < NumParams; ++ParamIndex )
+		{
+			for ( const float Duration : TestDurations )
+			{
+				const float Param = TestParams[ ParamIndex ];
+				const FBUIEasingTable* Table = EasingLUT.FindOrBuild( Type, Duration, Param );
+				if ( !Table )
+				{
+					++OutNumAnalytic;
+					continue;
+				}
+
+				for ( int32 i = 0; i <= NumSamples; ++i )
+				{
+					const float Time = Duration * i / NumSamples;
+					WorstError = FMath::Max( WorstError, FMath::Abs( FBUIEasingLUT::Ease( *Table, Type, Time, Duration, Param ) - FBUIEasing::Ease( Type, Time, Duration, Param ) ) );
+				}
+			}
+		}
+		return WorstError;
+	}
+
+
+	// Scalar and batched easing throughput per easing type
+	static void RunEasing( const TArray<FString>& Args )
+	{
+		const int32 NumSamples = ParseIntArg( Args, 0, 4096 );
+		const int32 NumRepeats = ParseIntArg( Args, 1, 200 );
+
+		const FEasingSamples Samples = MakeEasingSamples( NumSamples );
+		TArray<float> Values;
+		Values.SetNumUninitialized( NumSamples );
+
+		const UEnum* EasingEnum = StaticEnum<EBUIEasingType>();
+		UE_LOG( LogBUITween, Display, TEXT( "BUITween easing benchmark: %d samples x %d repeats" ), NumSamples, NumRepeats );
+		for ( int32 TypeIndex = 0; TypeIndex < FBUIEasing::NumTypes; ++TypeIndex )
+		{
+			const EBUIEasingType Type = static_cast<EBUIEasingType>( TypeIndex );
+
+			double StartTime = FPlatformTime::Seconds();
+			for ( int32 Repeat = 0; Repeat < NumRepeats; ++Repeat )
+			{
+				for ( int32 i = 0; i < NumSamples; ++i )
+				{
+					Values[ i ] = FBUIEasing::Ease( Type, Samples.Times[ i ], Samples.Durations[ i ], Samples.Params[ i ] );
+				}
+			}
+			const double ScalarSeconds = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for ( int32 Repeat = 0; Repeat < NumRepeats; ++Repeat )
+			{
+				FBUIEasing::EaseBatch( Type, Samples.Times.GetData(), Samples.Durations.GetData(), Samples.Params.GetData(), Values.GetData(), NumSamples );
+			}
+			const double BatchSeconds = FPlatformTime::Seconds() - StartTime;
+
+			const double NumEvaluated = double( NumSamples ) * NumRepeats;
+			UE_LOG( LogBUITween, Display, TEXT( "  %-14s scalar %8.1f M/s  batch %8.1f M/s" ),
+				*EasingEnum->GetNameStringByIndex( TypeIndex ),
+				NumEvaluated / FMath::Max( ScalarSeconds, 1e-9 ) / 1e6,
+				NumEvaluated / FMath::Max( BatchSeconds, 1e-9 ) / 1e6 );
+		}
+	}
+
+	// Lookup vs analytic throughput of the easing tables, over the same params and durations
+	static void RunEasingLUT( const TArray<FString>& Args )
+	{
+		const UBUITweenSettings* Settings = GetDefault<UBUITweenSettings>();
+		const int32 Resolution = ParseIntArg( Args, 0, Settings->EasingLUTResolution );
+		const float MaxError = ParseFloatArg( Args, 1, Settings->EasingLUTMaxError );
+		const int32 NumSamples = ParseIntArg( Args, 2, 100000 );
+
+		// Our own tables so the running game's aren't rebuilt
+		FBUIEasingLUT EasingLUT;
+		EasingLUT.Configure( true, Resolution, MaxError, TNumericLimits<int32>::Max() );
+
+		const UEnum* EasingEnum = StaticEnum<EBUIEasingType>();
+		UE_LOG( LogBUITween, Display, TEXT( "BUITween easing LUT benchmark: resolution %d, max error %g, %d samples per curve" ), Resolution, MaxError, NumSamples );
+		for ( int32 TypeIndex = 0; TypeIndex < FBUIEasing::NumTypes; ++TypeIndex )
+		{
+			const EBUIEasingType Type = static_cast<EBUIEasingType>( TypeIndex );
+			if ( !FBUIEasingLUT::UsesTable( Type ) )
+			{
+				continue;
+			}
+
+			const int32 NumParams = FBUIEasingLUT::IsKeyedOnParam( Type ) ? UE_ARRAY_COUNT( TestParams ) : 1;
+			int32 NumAnalytic = 0;
+			double AnalyticSeconds = 0;
+			double TableSeconds = 0;
+			for ( int32 ParamIndex = 0; ParamIndex < NumParams; ++ParamIndex )
+			{
+				for ( const float Duration : TestDurations )
+				{
+					const float Param = TestParams[ ParamIndex ];
+					const FBUIEasingTable* Table = EasingLUT.FindOrBuild( Type, Duration, Param );
+					if ( !Table )
+					{
+						++NumAnalytic;
+						continue;
+					}
+
+					float AnalyticSum = 0;
+					double StartTime = FPlatformTime::Seconds();
+					for ( int32 i = 0; i <= NumSamples; ++i )
+					{
+						AnalyticSum += FBUIEasing::Ease( Type, Duration * i / NumSamples, Duration, Param );
+					}
+					AnalyticSeconds += FPlatformTime::Seconds() - StartTime;
+
+					float TableSum = 0;
+					StartTime = FPlatformTime::Seconds();
+					for ( int32 i = 0; i <= NumSamples; ++i )
+					{
+						TableSum += FBUIEasingLUT::Ease( *Table, Type, Duration * i / NumSamples, Duration, Param );
+					}
+					TableSeconds += FPlatformTime::Seconds() - StartTime;
+
+					// Keeps the timed loops from being optimized away
+					Sink = AnalyticSum + TableSum;
+				}
+			}
+
+			UE_LOG( LogBUITween, Display, TEXT( "  %-14s analytic fallbacks %d  lookup %.2fx analytic" ),
+				*EasingEnum->GetNameStringByIndex( TypeIndex ),
+				NumAnalytic,
+				TableSeconds > 0 ? AnalyticSeconds / TableSeconds : 0.0 );
+		}
+
+		UE_LOG( LogBUITween, Display, TEXT( "  %d tables" ), EasingLUT.NumTables() );
+	}
+
+	// Forwards to the real allocator, counting the game thread's allocations. Only installed around
+	// the measured updates.
+	class FCountingMalloc : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc( FMalloc* InInner )
+			: Inner( InInner )
+		{
+		}
+
+		int64 NumAllocations = 0;
+
+		virtual void* Malloc( SIZE_T Count, uint32 Alignment ) override
+		{
+			CountIfGameThread();
+			return Inner->Malloc( Count, Alignment );
+		}
+		virtual void* Realloc( void* Original, SIZE_T Count, uint32 Alignment ) override
+		{
+			CountIfGameThread();
+			return Inner->Realloc( Original, Count, Alignment );
+		}
+		virtual void Free( void* Original ) override
+		{
+			Inner->Free( Original );
+		}
+		virtual SIZE_T QuantizeSize( SIZE_T Count, uint32 Alignment ) override
+		{
+			return Inner->QuantizeSize( Count, Alignment );
+		}
+		virtual bool GetAllocationSize( void* Original, SIZE_T& SizeOut ) override
+		{
+			return Inner->GetAllocationSize( Original, SizeOut );
+		}
+		virtual void Trim( bool bTrimThreadCaches ) override
+		{
+			Inner->Trim( bTrimThreadCaches );
+		}
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+		virtual bool ValidateHeap() override
+		{
+			return Inner->ValidateHeap();
+		}
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT( "BUITweenCountingMalloc" );
+		}
+
+	private:
+		void CountIfGameThread()
+		{
+			if ( IsInGameThread() )
+			{
+				++NumAllocations;
+			}
+		}
+
+		FMalloc* Inner;
+	};
+
+	FUpdateResult RunUpdateCase( int32 NumTweens, int32 NumFrames )
+	{
+		const float DeltaTime = 1.0f / 60.0f;
+		// Long enough for every tween to have completed and restarted at least once
+		const int32 NumWarmupFrames = 180;
+
+		TArray<UWidget*> Widgets;
+		CreateWidgets( NumTweens, Widgets );
+
+		// Every widget can have a completing tween and its replacement in the same frame
+		FBUITweenStorage Storage;
+		Storage.Reserve( FMath::Max( GetDefault<UBUITweenSettings>()->ReservedTweenCapacity, NumTweens * 2 ) );
+		FRandomStream Random( NumTweens );
+
+		TFunction<void( UWidget* )> StartTween;
+		StartTween = [ & ]( UWidget* pWidget )
+		{
+			FBUITweenInstance& Tween = Storage.Create( pWidget, Random.FRandRange( 0.25f, 2.0f ), Random.FRand() < 0.25f ? Random.FRandRange( 0.0f, 0.5f ) : 0.0f );
+			Tween.Easing( static_cast<EBUIEasingType>( Random.RandHelper( FBUIEasing::NumTypes ) ) );
+			switch ( Random.RandHelper( 4 ) )
+			{
+				case 0:
+					Tween.ToTranslation( Random.FRandRange( -100, 100 ), Random.FRandRange( -100, 100 ) ).ToOpacity( Random.FRand() );
+					break;
+				case 1:
+					Tween.ToScale( FVector2D( Random.FRandRange( 0.5f, 1.5f ) ) ).ToRotation( Random.FRandRange( -180, 180 ) );
+					break;
+				case 2:
+					Tween.ToColor( FLinearColor( Random.FRand(), Random.FRand(), Random.FRand() ) ).ToOpacity( Random.FRand() );
+					break;
+				default:
+					Tween.ToTranslation( Random.FRandRange( -100, 100 ), 0 ).ToScale( FVector2D( 1.1f ) ).ToRotation( 10 ).ToVisibility( ESlateVisibility::HitTestInvisible );
+					break;
+			}
+			Tween.OnComplete( [ &StartTween ]( UWidget* pOwner )
+			{
+				if ( pOwner )
+				{
+					StartTween( pOwner );
+				}
+			} );
+			Tween.Begin();
+		};
+
+		for ( UWidget* pWidget : Widgets )
+		{
+			StartTween( pWidget );
+		}
+		for ( int32 Frame = 0; Frame < NumWarmupFrames; ++Frame )
+		{
+			Storage.Update( DeltaTime );
+		}
+
+		const uint64 StartProcessBytes = FPlatformMemory::GetStats().UsedPhysical;
+		uint64 PeakProcessBytes = 0;
+		SIZE_T PeakStorageBytes = 0;
+		double UpdateSeconds = 0;
+
+		// Only counting inside Update, the memory queries below allocate on some platforms
+		FMalloc* PreviousMalloc = GMalloc;
+		FCountingMalloc CountingMalloc( PreviousMalloc );
+
+		for ( int32 Frame = 0; Frame < NumFrames; ++Frame )
+		{
+			GMalloc = &CountingMalloc;
+			const double StartTime = FPlatformTime::Seconds();
+			Storage.Update( DeltaTime );
+			UpdateSeconds += FPlatformTime::Seconds() - StartTime;
+			GMalloc = PreviousMalloc;
+
+			PeakStorageBytes = FMath::Max( PeakStorageBytes, Storage.GetHeaderAllocatedSize() + Storage.GetChannelAllocatedSize() + Storage.GetInstanceAllocatedSize() );
+			const uint64 ProcessBytes = FPlatformMemory::GetStats().UsedPhysical;
+			PeakProcessBytes = FMath::Max( PeakProcessBytes, ProcessBytes > StartProcessBytes ? ProcessBytes - StartProcessBytes : 0 );
+		}
+
+		// The restart callbacks reference StartTween, so don't let them outlive it
+		Storage.Empty();
+
+		FUpdateResult Result;
+		Result.NumTweens = NumTweens;
+		Result.NumFrames = NumFrames;
+		Result.NsPerTweenFrame = UpdateSeconds * 1e9 / ( double( NumTweens ) * NumFrames );
+		Result.AllocationsPerFrame = double( CountingMalloc.NumAllocations ) / NumFrames;
+		Result.PeakStorageBytes = PeakStorageBytes;
+		Result.PeakProcessBytes = PeakProcessBytes;
+		return Result;
+	}
+
+	static void RunUpdate( const TArray<FString>& Args )
+	{
+		const int32 NumFrames = ParseIntArg( Args, 0, 300 );
+		TArray<int32> TweenCounts = { 10, 100, 1000, 10000 };
+		if ( Args.Num() > 1 )
+		{
+			TweenCounts.Reset();
+			for ( int32 i = 1; i < Args.Num(); ++i )
+			{
+				TweenCounts.Add( ParseIntArg( Args, i, 1 ) );
+			}
+		}
+
+		FString Csv = TEXT( "NumTweens,NumFrames,NsPerTweenFrame,AllocationsPerFrame,PeakStorageBytes,PeakProcessDeltaBytes\n" );
+		UE_LOG( LogBUITween, Display, TEXT( "BUITween update benchmark: %d frames" ), NumFrames );
+		for ( int32 NumTweens : TweenCounts )
+		{
+			const FUpdateResult Result = RunUpdateCase( NumTweens, NumFrames );
+			UE_LOG( LogBUITween, Display, TEXT( "  %6d tweens: %8.1f ns/tween/frame  %6.1f allocs/frame  peak storage %8.1f KB  peak process delta %8.1f KB" ),
+				Result.NumTweens, Result.NsPerTweenFrame, Result.AllocationsPerFrame, Result.PeakStorageBytes / 1024.0, Result.PeakProcessBytes / 1024.0 );
+			Csv += FString::Printf( TEXT( "%d,%d,%.2f,%.2f,%llu,%llu\n" ),
+				Result.NumTweens, Result.NumFrames, Result.NsPerTweenFrame, Result.AllocationsPerFrame, uint64( Result.PeakStorageBytes ), Result.PeakProcessBytes );
+		}
+
+		const FString Filename = FPaths::ProfilingDir() / TEXT( "BUITween" ) / FString::Printf( TEXT( "UpdateBenchmark-%s.csv" ), *FDateTime::Now().ToString() );
+		if ( FFileHelper::SaveStringToFile( Csv, *Filename ) )
+		{
+			UE_LOG( LogBUITween, Display, TEXT( "  wrote %s" ), *FPaths::ConvertRelativePathToFull( Filename ) );
+		}
+		else
+		{
+			UE_LOG( LogBUITween, Error, TEXT( "Couldn't write the benchmark results to %s" ), *Filename );
+		}
+	}
+
+	FUpdateResult RunSteadyStateCase( int32 NumTweens, int32 NumFrames )
+	{
+		IConsoleVariable* ParallelEvaluate = IConsoleManager::Get().FindConsoleVariable( TEXT( "BUITween.ParallelEvaluate" ) );
+		const int32 PreviousParallelEvaluate = ParallelEvaluate->GetInt();
+		ParallelEvaluate->Set( 0, ECVF_SetByCode );
+
+		const FUpdateResult Result = RunUpdateCase( NumTweens, NumFrames );
+
+		ParallelEvaluate->Set( PreviousParallelEvaluate, ECVF_SetByCode );
+		return Result;
+	}
+}
+
+static FAutoConsoleCommand BUITweenBenchmarkClearCommand(
+	TEXT( "BUITween.Benchmark.Clear" ),
+	TEXT( "Restarts a non-additive tween on every widget each frame and compares against a linear scan. Args: [NumWidgets=500] [NumFrames=60]" ),
+	FConsoleCommandWithArgsDelegate::CreateStatic( &BUITweenBenchmark::RunClear )
+);
+
+static FAutoConsoleCommand BUITweenBenchmarkEasingCommand(
+	TEXT( "BUITween.Benchmark.Easing" ),
+	TEXT( "Logs the scalar and batched easing throughput per easing type. Args: [NumSamples=4096] [NumRepeats=200]" ),
+	FConsoleCommandWithArgsDelegate::CreateStatic( &BUITweenBenchmark::RunEasing )
+);
+
+static FAutoConsoleCommand BUITweenBenchmarkEasingLUTCommand(
+	TEXT( "BUITween.Benchmark.EasingLUT" ),
+	TEXT( "Logs the easing lookup table throughput against the analytic curves. Args: [Resolution] [MaxError] [NumSamples=100000], defaults from the BUITween settings" ),
+	FConsoleCommandWithArgsDelegate::CreateStatic( &BUITweenBenchmark::RunEasingLUT )
+);
+
+static FAutoConsoleCommand BUITweenBenchmarkUpdateCommand(
+	TEXT( "BUITween.Benchmark.Update" ),
+	TEXT( "Runs 10, 100, 1k and 10k tweens with mixed properties and easings and writes ns/tween/frame, allocations/frame and peak memory to Saved/Profiling/BUITween. Args: [NumFrames=300] [NumTweens...]" ),
+	FConsoleCommandWithArgsDelegate::CreateStatic( &BUITweenBenchmark::RunUpdate )
+);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+
+class FBUIEasingLUT;
+
+// Measurements shared by the benchmark console commands, which report throughput, and the automation
+// tests in Private/Tests, which check the results
+namespace BUITweenBenchmark
+{
+	// Batched and scalar easing only differ by float rounding
+	constexpr float EaseBatchTolerance = 1e-4f;
+
+	// Random times, durations and params, with both ends of the curve hit exactly as that's where the
+	// special cases live
+	struct FEasingSamples
+	{
+		TArray<float> Times;
+		TArray<float> Durations;
+		TArray<float> Params;
+	};
+	FEasingSamples MakeEasingSamples( int32 NumSamples );
+
+	// Largest difference between FBUIEasing::EaseBatch and FBUIEasing::Ease over the samples
+	float MeasureBatchError( EBUIEasingType Type, const FEasingSamples& Samples );
+
+	// Worst error of the type's tables against the analytic curve, over the params and durations a UI
+	// typically uses. OutNumAnalytic counts the combinations that got no table.
+	float MeasureLUTError( FBUIEasingLUT& EasingLUT, EBUIEasingType Type, int32 NumSamples, int32& OutNumAnalytic );
+
+	struct FUpdateResult
+	{
+		int32 NumTweens;
+		int32 NumFrames;
+		double NsPerTweenFrame;
+		double AllocationsPerFrame;
+		SIZE_T PeakStorageBytes;
+		uint64 PeakProcessBytes;
+	};
+
+	// Keeps NumTweens running on their own widgets with mixed properties and easings, restarting each
+	// one from its complete callback, and measures Update over NumFrames fixed 60Hz frames
+	FUpdateResult RunUpdateCase( int32 NumTweens, int32 NumFrames );
+	// The same with the evaluate phase kept on the game thread, since ParallelFor allocates its own task
+	// data. Warm tweens at hover/press/focus sized counts must then make no allocations.
+	FUpdateResult RunSteadyStateCase( int32 NumTweens, int32 NumFrames );
+}
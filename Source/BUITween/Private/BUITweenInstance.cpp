@@ -1,167 +1,257 @@
 #include "BUITweenInstance.h"
 
 #include "Components/Widget.h"
-#include "Components/Image.h"
-#include "Components/Border.h"
-#include "Components/CanvasPanelSlot.h"
-#include "Components/OverlaySlot.h"
-#include "Components/VerticalBoxSlot.h"
-#include "Components/HorizontalBoxSlot.h"
-#include "Components/SizeBox.h"
-#include "Blueprint/UserWidget.h"
+#include "BUITweenStagger.h"
+#include "BUITweenStorage.h"
+#include "BUITweenStats.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Curves/CurveFloat.h"
+#include "Widgets/SWidget.h"
 
 DEFINE_LOG_CATEGORY(LogBUITween);
 
 void FBUITweenInstance::Begin()
 {
+	BUITWEEN_SCOPE( Begin );
+
+	// Once running the header holds the tween's state, values captured here again would never be read
+	const FBUITweenStorage* Storage = Handle.IsValid() ? FBUITweenStorage::FindById( Handle.StorageId ) : nullptr;
+	if ( Storage && !ensureMsgf( Storage->IsPending( Handle ), TEXT( "Tweens can only be begun before their first update, create a new one to restart" ) ) )
+	{
+		return;
+	}
+
 	bShouldUpdate = true;
 	bHasPlayedStartEvent = false;
 	bHasPlayedCompleteEvent = false;
 
+	if ( pStagger )
+	{
+		// Elements only keep start values for the fixed props, they have no material or property bindings
+		if ( !ensureMsgf( MaterialParams.Num() == 0 && Properties.Num() == 0, TEXT( "Staggered tweens can't play material parameters or properties, they are dropped" ) ) )
+		{
+			MaterialParams.Reset();
+			Properties.Reset();
+		}
+		pStagger->Begin( *this );
+		return;
+	}
+
+	if ( TSharedPtr<SWidget> Slate = SlateWidget.Pin() )
+	{
+		CaptureSlateStartValues( *Slate );
+		ApplySlate( *Slate, 0 );
+		return;
+	}
+
 	if ( !pWidget.IsValid() )
 	{
 		UE_LOG( LogBUITween, Warning, TEXT( "Trying to start invalid widget" ) );
 		return;
 	}
 
+	Targets.Resolve( pWidget.Get() );
+	CaptureStartValues();
+
+	// Apply the starting conditions, even if we delay
+	Apply( 0 );
+}
+
+void FBUITweenInstance::CaptureStartValues()
+{
+	UWidget* Target = pWidget.Get();
+
 	// Set all the props to the existng state
-	TranslationProp.OnBegin( pWidget->GetRenderTransform().Translation );
-	ScaleProp.OnBegin( pWidget->GetRenderTransform().Scale );
-	RotationProp.OnBegin( pWidget->GetRenderTransform().Angle );
-	OpacityProp.OnBegin( pWidget->GetRenderOpacity() );
+	const FWidgetTransform& CurrentTransform = Target->GetRenderTransform();
+	TranslationProp.OnBegin( CurrentTransform.Translation );
+	ScaleProp.OnBegin( CurrentTransform.Scale );
+	RotationProp.OnBegin( CurrentTransform.Angle );
+	OpacityProp.OnBegin( Target->GetRenderOpacity() );
+	VisibilityProp.OnBegin( Target->GetVisibility() );
 
+	FLinearColor CurrentColor;
+	if ( ColorProp.IsSet() && Targets.GetColor( Target, CurrentColor ) )
 	{
-		UUserWidget* UW = Cast<UUserWidget>( pWidget );
-		if ( UW )
-		{
-			ColorProp.OnBegin( UW->GetColorAndOpacity() );
-		}
-		UImage* UI = Cast<UImage>( pWidget );
-		if ( UI )
-		{
-			ColorProp.OnBegin( UI->GetColorAndOpacity() );
-		}
-		UBorder* Border = Cast<UBorder>( pWidget );
-		if ( Border )
-		{
-			ColorProp.OnBegin( Border->GetContentColorAndOpacity() );
-		}
+		ColorProp.OnBegin( CurrentColor );
 	}
 
-	VisibilityProp.OnBegin( pWidget->GetVisibility() );
-
-	UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>( pWidget->Slot );
-	if ( CanvasSlot )
+	FVector2D CurrentPosition;
+	if ( CanvasPositionProp.IsSet() && Targets.GetCanvasPosition( Target, CurrentPosition ) )
 	{
-		CanvasPositionProp.OnBegin( CanvasSlot->GetPosition() );
+		CanvasPositionProp.OnBegin( CurrentPosition );
 	}
-	UOverlaySlot* OverlaySlot = Cast<UOverlaySlot>( pWidget->Slot );
-	UHorizontalBoxSlot* HorizontalBoxSlot = Cast<UHorizontalBoxSlot>( pWidget->Slot );
-	UVerticalBoxSlot* VerticalBoxSlot = Cast<UVerticalBoxSlot>( pWidget->Slot );
-	if ( OverlaySlot )
+
+	FMargin CurrentPadding;
+	if ( PaddingProp.IsSet() && Targets.GetPadding( Target, CurrentPadding ) )
 	{
-		PaddingProp.OnBegin( FVector4(
-			OverlaySlot->GetPadding().Left,
-			OverlaySlot->GetPadding().Top,
-			OverlaySlot->GetPadding().Bottom,
-			OverlaySlot->GetPadding().Right ) );
+		PaddingProp.OnBegin( FVector4( CurrentPadding.Left, CurrentPadding.Top, CurrentPadding.Right, CurrentPadding.Bottom ) );
 	}
-	else if ( HorizontalBoxSlot )
+
+	float CurrentHeight;
+	if ( MaxDesiredHeightProp.IsSet() && Targets.GetMaxDesiredHeight( Target, CurrentHeight ) )
 	{
-		PaddingProp.OnBegin( FVector4(
-			HorizontalBoxSlot->GetPadding().Left,
-			HorizontalBoxSlot->GetPadding().Top,
-			HorizontalBoxSlot->GetPadding().Bottom,
-			HorizontalBoxSlot->GetPadding().Right ) );
+		MaxDesiredHeightProp.OnBegin( CurrentHeight );
 	}
-	else if ( VerticalBoxSlot )
+
+	UMaterialInstanceDynamic* pMaterialInstance = MaterialParams.Num() > 0 ? Targets.GetDynamicMaterial( Target ) : nullptr;
+	pMaterial = pMaterialInstance;
+	for ( FBUITweenMaterialParamProp& Param : MaterialParams )
 	{
-		PaddingProp.OnBegin( FVector4(
-			VerticalBoxSlot->GetPadding().Left,
-			VerticalBoxSlot->GetPadding().Top,
-			VerticalBoxSlot->GetPadding().Bottom,
-			VerticalBoxSlot->GetPadding().Right ) );
+		Param.ParameterIndex = INDEX_NONE;
+		if ( !pMaterialInstance )
+		{
+			continue;
+		}
+
+		// Setting the start value adds the parameter to the overrides, after that it's written by index
+		FLinearColor CurrentValue( ForceInitToZero );
+		if ( Param.bIsVector )
+		{
+			pMaterialInstance->GetVectorParameterValue( FMaterialParameterInfo( Param.Name ), CurrentValue );
+			Param.OnBegin( CurrentValue );
+			pMaterialInstance->InitializeVectorParameterAndGetIndex( Param.Name, Param.StartValue, Param.ParameterIndex );
+		}
+		else
+		{
+			pMaterialInstance->GetScalarParameterValue( FMaterialParameterInfo( Param.Name ), CurrentValue.R );
+			Param.OnBegin( CurrentValue );
+			pMaterialInstance->InitializeScalarParameterAndGetIndex( Param.Name, Param.StartValue.R, Param.ParameterIndex );
+		}
 	}
 
-	USizeBox* SizeBox = Cast<USizeBox>( pWidget );
-	if ( SizeBox )
+	for ( FBUITweenPropertyProp& Property : Properties )
 	{
-		MaxDesiredHeightProp.OnBegin( SizeBox->GetMaxDesiredHeight() );
+		Property.Binding = FBUITweenPropertyBinding::Find( Target->GetClass(), Property.Path );
+		FVector4 CurrentValue;
+		if ( Property.Binding.Read( Target, CurrentValue ) )
+		{
+			Property.OnBegin( CurrentValue );
+		}
+		else
+		{
+			// A setter can't be read back, without a From value it starts at its target
+			Property.OnBegin( Property.bHasStart ? Property.StartValue : Property.TargetValue );
+		}
 	}
+}
 
-	// Apply the starting conditions, even if we delay
-	Apply( 0 );
+void FBUITweenInstance::CaptureSlateStartValues( SWidget& InSlateWidget )
+{
+	const FWidgetTransform CurrentTransform = FBUITweenTargets::GetSlateRenderTransform( InSlateWidget );
+	TranslationProp.OnBegin( CurrentTransform.Translation );
+	ScaleProp.OnBegin( CurrentTransform.Scale );
+	RotationProp.OnBegin( CurrentTransform.Angle );
+	OpacityProp.OnBegin( InSlateWidget.GetRenderOpacity() );
 }
 
-void FBUITweenInstance::Update( float DeltaTime )
+FBUITweenInstance& FBUITweenInstance::RotationCurve( const FRichCurve& InCurve )
 {
-	if ( !bShouldUpdate && !bIsComplete )
-	{
-		return;
-	}
-	if ( !pWidget.IsValid() )
+	return BakeCurve( RotationProp, InCurve );
+}
+
+FBUITweenInstance& FBUITweenInstance::RotationCurve( const UCurveFloat* pInCurve )
+{
+	return BakeCurve( RotationProp, pInCurve );
+}
+
+FBUITweenInstance& FBUITweenInstance::OpacityCurve( const FRichCurve& InCurve )
+{
+	return BakeCurve( OpacityProp, InCurve );
+}
+
+FBUITweenInstance& FBUITweenInstance::OpacityCurve( const UCurveFloat* pInCurve )
+{
+	return BakeCurve( OpacityProp, pInCurve );
+}
+
+FBUITweenInstance& FBUITweenInstance::MaxDesiredHeightCurve( const FRichCurve& InCurve )
+{
+	return BakeCurve( MaxDesiredHeightProp, InCurve );
+}
+
+FBUITweenInstance& FBUITweenInstance::MaxDesiredHeightCurve( const UCurveFloat* pInCurve )
+{
+	return BakeCurve( MaxDesiredHeightProp, pInCurve );
+}
+
+FBUITweenInstance& FBUITweenInstance::BakeCurve( TBUITweenProp<float>& Prop, const FRichCurve& InCurve )
+{
+	FBUITweenCurve::Bake( InCurve, Prop.Keys );
+	if ( !bHasEasing )
 	{
-		bIsComplete = true;
-		return;
+		EasingType = EBUIEasingType::Linear;
 	}
+	return *this;
+}
 
-	if ( Delay > 0 )
+FBUITweenInstance& FBUITweenInstance::BakeCurve( TBUITweenProp<float>& Prop, const UCurveFloat* pInCurve )
+{
+	if ( !pInCurve )
 	{
-		// TODO could correctly subtract from deltatime and use rmaining on alpha but meh
-		Delay -= DeltaTime;
-		return;
+		UE_LOG( LogBUITween, Warning, TEXT( "Trying to tween along a null curve" ) );
+		return *this;
 	}
+	return BakeCurve( Prop, pInCurve->FloatCurve );
+}
 
-	if ( !bHasPlayedStartEvent )
+FBUITweenPropertyProp& FBUITweenInstance::FindOrAddProperty( FName InPath )
+{
+	for ( FBUITweenPropertyProp& Property : Properties )
 	{
-		OnStartedDelegate.ExecuteIfBound( pWidget.Get() );
-		OnStartedBPDelegate.ExecuteIfBound( pWidget.Get() );
-		bHasPlayedStartEvent = true;
+		if ( Property.Path == InPath )
+		{
+			return Property;
+		}
 	}
+	FBUITweenPropertyProp& Property = Properties.AddDefaulted_GetRef();
+	Property.Path = InPath;
+	return Property;
+}
 
-	// Tween each thingy
-	Alpha += DeltaTime;
-	if ( Alpha >= Duration )
+FBUITweenMaterialParamProp& FBUITweenInstance::FindOrAddMaterialParam( FName InName, bool bInIsVector )
+{
+	for ( FBUITweenMaterialParamProp& Param : MaterialParams )
 	{
-		Alpha = Duration;
-		bIsComplete = true;
+		if ( Param.Name == InName )
+		{
+			Param.bIsVector = bInIsVector;
+			return Param;
+		}
 	}
-
-	const float EasedAlpha = EasingParam.IsSet()
-		? FBUIEasing::Ease( EasingType, Alpha, Duration, EasingParam.GetValue() )
-		: FBUIEasing::Ease( EasingType, Alpha, Duration );
-
-	Apply( EasedAlpha );
+	FBUITweenMaterialParamProp& Param = MaterialParams.AddDefaulted_GetRef();
+	Param.Name = InName;
+	Param.bIsVector = bInIsVector;
+	return Param;
 }
 
-void FBUITweenInstance::Apply( float EasedAlpha )
+void FBUITweenInstance::Apply( float EasedAlpha, FBUITweenWidgetWrite* pWrite )
 {
 	UWidget* Target = pWidget.Get();
 
-	if ( ColorProp.IsSet() )
+	if ( ColorProp.IsSet() && ColorProp.Update( EasedAlpha ) )
 	{
-		ColorProp.Update( EasedAlpha );
-		UUserWidget* UW = Cast<UUserWidget>( Target );
-		if ( UW )
-		{
-			UW->SetColorAndOpacity( ColorProp.CurrentValue );
-		}
-		UImage* UI = Cast<UImage>( Target );
-		if ( UI )
+		if ( pWrite )
 		{
-			UI->SetColorAndOpacity( ColorProp.CurrentValue );
+			pWrite->Color = ColorProp.CurrentValue;
+			pWrite->pColorTargets = &Targets;
 		}
-		UBorder* Border = Cast<UBorder>( Target );
-		if ( Border )
+		else
 		{
-			Border->SetContentColorAndOpacity( ColorProp.CurrentValue );
+			Targets.SetColor( Target, ColorProp.CurrentValue );
 		}
 	}
 
-	if ( OpacityProp.IsSet() )
+	if ( OpacityProp.IsSet() && OpacityProp.Update( EasedAlpha ) )
 	{
-		OpacityProp.Update( EasedAlpha );
-		Target->SetRenderOpacity( OpacityProp.CurrentValue );
+		if ( pWrite )
+		{
+			pWrite->Opacity = OpacityProp.CurrentValue;
+			pWrite->bHasOpacity = true;
+		}
+		else
+		{
+			Target->SetRenderOpacity( OpacityProp.CurrentValue );
+		}
 	}
 
 	// Only apply visibility changes at 0 or 1
@@ -174,19 +264,23 @@ void FBUITweenInstance::Apply( float EasedAlpha )
 	}
 
 	bool bChangedRenderTransform = false;
-	FWidgetTransform CurrentTransform = Target->GetRenderTransform();
+	FWidgetTransform CurrentTransform = pWrite && pWrite->bHasTransform ? pWrite->Transform : Target->GetRenderTransform();
 
 	if ( TranslationProp.IsSet() )
 	{
-		TranslationProp.Update( EasedAlpha );
-		CurrentTransform.Translation = TranslationProp.CurrentValue;
-		bChangedRenderTransform = true;
+		if ( TranslationProp.Update( EasedAlpha ) )
+		{
+			CurrentTransform.Translation = TranslationProp.CurrentValue;
+			bChangedRenderTransform = true;
+		}
 	}
 	if ( ScaleProp.IsSet() )
 	{
-		ScaleProp.Update( EasedAlpha );
-		CurrentTransform.Scale = ScaleProp.CurrentValue;
-		bChangedRenderTransform = true;
+		if ( ScaleProp.Update( EasedAlpha ) )
+		{
+			CurrentTransform.Scale = ScaleProp.CurrentValue;
+			bChangedRenderTransform = true;
+		}
 	}
 	if ( RotationProp.IsSet() )
 	{
@@ -200,40 +294,145 @@ void FBUITweenInstance::Apply( float EasedAlpha )
 	{
 		if ( CanvasPositionProp.Update( EasedAlpha ) )
 		{
-			UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>( pWidget->Slot );
-			if ( CanvasSlot )
-				CanvasSlot->SetPosition( CanvasPositionProp.CurrentValue );
+			Targets.SetCanvasPosition( Target, CanvasPositionProp.CurrentValue );
 		}
 	}
 	if ( PaddingProp.IsSet() )
 	{
 		if ( PaddingProp.Update( EasedAlpha ) )
 		{
-			UOverlaySlot* OverlaySlot = Cast<UOverlaySlot>( pWidget->Slot );
-			UHorizontalBoxSlot* HorizontalBoxSlot = Cast<UHorizontalBoxSlot>( pWidget->Slot );
-			UVerticalBoxSlot* VerticalBoxSlot = Cast<UVerticalBoxSlot>( pWidget->Slot );
-			if ( OverlaySlot )
-				OverlaySlot->SetPadding( PaddingProp.CurrentValue );
-			else if ( HorizontalBoxSlot )
-				HorizontalBoxSlot->SetPadding( PaddingProp.CurrentValue );
-			else if ( VerticalBoxSlot )
-				VerticalBoxSlot->SetPadding( PaddingProp.CurrentValue );
+			const FVector4& Padding = PaddingProp.CurrentValue;
+			Targets.SetPadding( Target, FMargin( Padding.X, Padding.Y, Padding.Z, Padding.W ) );
 		}
 	}
 	if ( MaxDesiredHeightProp.IsSet() )
 	{
 		if ( MaxDesiredHeightProp.Update( EasedAlpha ) )
 		{
-			USizeBox* SizeBox = Cast<USizeBox>( pWidget );
-			if ( SizeBox )
+			Targets.SetMaxDesiredHeight( Target, MaxDesiredHeightProp.CurrentValue );
+		}
+	}
+
+	if ( bChangedRenderTransform && pWrite )
+	{
+		pWrite->Transform = CurrentTransform;
+		pWrite->bHasTransform = true;
+	}
+	else if ( bChangedRenderTransform )
+	{
+		Target->SetRenderTransform( CurrentTransform );
+	}
+
+	for ( FBUITweenPropertyProp& Property : Properties )
+	{
+		if ( Property.Binding.IsValid() && Property.Update( EasedAlpha ) )
+		{
+			Property.Binding.Write( Target, Property.CurrentValue );
+		}
+	}
+
+	if ( UMaterialInstanceDynamic* pMaterialInstance = pMaterial.Get() )
+	{
+		for ( FBUITweenMaterialParamProp& Param : MaterialParams )
+		{
+			if ( Param.ParameterIndex != INDEX_NONE && Param.Update( EasedAlpha ) )
 			{
-				SizeBox->SetMaxDesiredHeight( MaxDesiredHeightProp.CurrentValue );
+				FBUITweenTargets::SetMaterialParameter( pMaterialInstance, Param.Name, Param.bIsVector, Param.ParameterIndex, Param.CurrentValue );
 			}
 		}
 	}
+}
 
-	if ( bChangedRenderTransform )
+void FBUITweenInstance::ApplySlate( SWidget& InSlateWidget, float EasedAlpha )
+{
+	if ( OpacityProp.IsSet() && OpacityProp.Update( EasedAlpha ) )
 	{
-		Target->SetRenderTransform( CurrentTransform );
+		InSlateWidget.SetRenderOpacity( OpacityProp.CurrentValue );
+	}
+
+	if ( TranslationProp.IsSet() || ScaleProp.IsSet() || RotationProp.IsSet() )
+	{
+		FWidgetTransform CurrentTransform = FBUITweenTargets::GetSlateRenderTransform( InSlateWidget );
+		if ( TranslationProp.IsSet() )
+		{
+			TranslationProp.Update( EasedAlpha );
+			CurrentTransform.Translation = TranslationProp.CurrentValue;
+		}
+		if ( ScaleProp.IsSet() )
+		{
+			ScaleProp.Update( EasedAlpha );
+			CurrentTransform.Scale = ScaleProp.CurrentValue;
+		}
+		if ( RotationProp.IsSet() )
+		{
+			RotationProp.Update( EasedAlpha );
+			CurrentTransform.Angle = RotationProp.CurrentValue;
+		}
+		FBUITweenTargets::SetSlateRenderTransform( InSlateWidget, CurrentTransform );
+	}
+}
+
+void FBUITweenInstance::DoStartEvent()
+{
+	if ( DoNativeEvent( EBUITweenEvent::Start ) )
+	{
+		DoBlueprintEvent( EBUITweenEvent::Start );
+	}
+}
+
+void FBUITweenInstance::DoCompleteCleanup()
+{
+	if ( DoNativeEvent( EBUITweenEvent::Complete ) )
+	{
+		DoBlueprintEvent( EBUITweenEvent::Complete );
+	}
+}
+
+bool FBUITweenInstance::DoNativeEvent( EBUITweenEvent Type )
+{
+	// Per tween rather than a cycle stat, so an expensive callback stands out in Insights
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL( BUITween_DoNativeEvent, BUITweenChannel );
+	switch ( Type )
+	{
+	case EBUITweenEvent::Start:
+		if ( bHasPlayedStartEvent )
+		{
+			return false;
+		}
+		bHasPlayedStartEvent = true;
+		OnStartedCallback.ExecuteIfBound( pWidget.Get() );
+		OnStartedDelegate.ExecuteIfBound( pWidget.Get() );
+		break;
+	case EBUITweenEvent::Loop:
+		OnLoopCallback.ExecuteIfBound( pWidget.Get() );
+		OnLoopDelegate.ExecuteIfBound( pWidget.Get() );
+		break;
+	case EBUITweenEvent::Complete:
+		if ( bHasPlayedCompleteEvent )
+		{
+			return false;
+		}
+		bHasPlayedCompleteEvent = true;
+		OnCompleteCallback.ExecuteIfBound( pWidget.Get() );
+		OnCompleteDelegate.ExecuteIfBound( pWidget.Get() );
+		break;
+	}
+	return true;
+}
+
+void FBUITweenInstance::DoBlueprintEvent( EBUITweenEvent Type )
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL( BUITween_DoBlueprintEvent, BUITweenChannel );
+	switch ( Type )
+	{
+	case EBUITweenEvent::Start:
+		OnStartedBPDelegate.ExecuteIfBound( pWidget.Get() );
+		break;
+	case EBUITweenEvent::Loop:
+		OnLoopBPDelegate.ExecuteIfBound( pWidget.Get() );
+		break;
+	case EBUITweenEvent::Complete:
+		OnCompleteBPDelegate.ExecuteIfBound( pWidget.Get() );
+		break;
 	}
 }
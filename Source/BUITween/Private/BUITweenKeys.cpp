@@ -0,0 +1,42 @@
+#include "BUITweenKeys.h"
+
+#include "Curves/RichCurve.h"
+
+void FBUITweenCurve::Bake( const FRichCurve& InCurve, TBUITweenKeys<float>& OutKeys )
+{
+	OutKeys.Reset();
+
+	const TArray< FRichCurveKey >& CurveKeys = InCurve.GetConstRefOfKeys();
+	if ( CurveKeys.Num() == 0 )
+	{
+		return;
+	}
+
+	const float MinTime = CurveKeys[ 0 ].Time;
+	const float Range = CurveKeys.Last().Time - MinTime;
+	auto ToAlpha = [ MinTime, Range ]( float Time )
+	{
+		return Range > 0 ? ( Time - MinTime ) / Range : 0.0f;
+	};
+
+	OutKeys.Add( 0, CurveKeys[ 0 ].Value, EBUIEasingType::Linear, FBUIEasing::DefaultParam );
+	for ( int32 i = 1; i < CurveKeys.Num(); ++i )
+	{
+		const FRichCurveKey& From = CurveKeys[ i - 1 ];
+		const FRichCurveKey& To = CurveKeys[ i ];
+		if ( From.InterpMode == RCIM_Constant )
+		{
+			// Two keys at the same time make a step
+			OutKeys.Add( ToAlpha( To.Time ), From.Value, EBUIEasingType::Linear, FBUIEasing::DefaultParam );
+		}
+		else if ( From.InterpMode == RCIM_Cubic )
+		{
+			for ( int32 Sample = 1; Sample < SamplesPerSegment; ++Sample )
+			{
+				const float Time = FMath::Lerp( From.Time, To.Time, Sample / static_cast<float>( SamplesPerSegment ) );
+				OutKeys.Add( ToAlpha( Time ), InCurve.Eval( Time ), EBUIEasingType::Linear, FBUIEasing::DefaultParam );
+			}
+		}
+		OutKeys.Add( ToAlpha( To.Time ), To.Value, EBUIEasingType::Linear, FBUIEasing::DefaultParam );
+	}
+}
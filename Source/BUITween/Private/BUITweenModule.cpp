@@ -1,8 +1,33 @@
 #include "BUITweenModule.h"
 #include "BUITween.h"
+#include "BUITweenStats.h"
 
 #define LOCTEXT_NAMESPACE "FBUITweenModule"
 
+DEFINE_STAT( STAT_BUITween_Update );
+DEFINE_STAT( STAT_BUITween_Evaluate );
+DEFINE_STAT( STAT_BUITween_Cull );
+DEFINE_STAT( STAT_BUITween_Apply );
+DEFINE_STAT( STAT_BUITween_Callbacks );
+DEFINE_STAT( STAT_BUITween_BlueprintCallbacks );
+DEFINE_STAT( STAT_BUITween_Begin );
+DEFINE_STAT( STAT_BUITween_NumActive );
+DEFINE_STAT( STAT_BUITween_NumPending );
+DEFINE_STAT( STAT_BUITween_NumStarted );
+DEFINE_STAT( STAT_BUITween_NumLooped );
+DEFINE_STAT( STAT_BUITween_NumCompleted );
+DEFINE_STAT( STAT_BUITween_NumWrites );
+DEFINE_STAT( STAT_BUITween_NumWritesAvoided );
+DEFINE_STAT( STAT_BUITween_NumCulled );
+DEFINE_STAT( STAT_BUITween_HeaderMemory );
+DEFINE_STAT( STAT_BUITween_ChannelMemory );
+DEFINE_STAT( STAT_BUITween_InstanceMemory );
+
+UE_TRACE_CHANNEL_DEFINE( BUITweenChannel );
+
+TRACE_DECLARE_INT_COUNTER( BUITween_NumActive, TEXT( "BUITween/Active Tweens" ) );
+TRACE_DECLARE_INT_COUNTER( BUITween_NumWrites, TEXT( "BUITween/Widget Writes" ) );
+
 void FBUITweenModule::StartupModule()
 {
 	this->LastFrameNumberWeTicked = INDEX_NONE;
@@ -0,0 +1,235 @@
+#include "BUITweenProperty.h"
+
+#include "BUITweenInstance.h"
+#include "UObject/UnrealType.h"
+#include "UObject/ObjectKey.h"
+#include "Layout/Margin.h"
+
+// Largest parameter block a setter can take, one FLinearColor or a double FVector2D
+static const int32 MaxSetterParamsSize = 32;
+
+static EBUITweenPropertyType GetPropertyType( const FProperty* pProperty )
+{
+	if ( pProperty->IsA<FFloatProperty>() )
+	{
+		return EBUITweenPropertyType::Float;
+	}
+	if ( pProperty->IsA<FDoubleProperty>() )
+	{
+		return EBUITweenPropertyType::Double;
+	}
+	if ( const FStructProperty* pStructProperty = CastField<FStructProperty>( pProperty ) )
+	{
+		if ( pStructProperty->Struct == TBaseStructure<FVector2D>::Get() )
+		{
+			return EBUITweenPropertyType::Vector2D;
+		}
+		if ( pStructProperty->Struct == TBaseStructure<FLinearColor>::Get() )
+		{
+			return EBUITweenPropertyType::LinearColor;
+		}
+		if ( pStructProperty->Struct == FMargin::StaticStruct() )
+		{
+			return EBUITweenPropertyType::Margin;
+		}
+	}
+	return EBUITweenPropertyType::None;
+}
+
+static void StoreValue( EBUITweenPropertyType Type, void* pDest, const FVector4& InValue )
+{
+	switch ( Type )
+	{
+		case EBUITweenPropertyType::Float:
+			*static_cast<float*>( pDest ) = InValue.X;
+			break;
+		case EBUITweenPropertyType::Double:
+			*static_cast<double*>( pDest ) = InValue.X;
+			break;
+		case EBUITweenPropertyType::Vector2D:
+			*static_cast<FVector2D*>( pDest ) = FVector2D( InValue.X, InValue.Y );
+			break;
+		case EBUITweenPropertyType::LinearColor:
+			*static_cast<FLinearColor*>( pDest ) = FLinearColor( InValue.X, InValue.Y, InValue.Z, InValue.W );
+			break;
+		case EBUITweenPropertyType::Margin:
+			*static_cast<FMargin*>( pDest ) = FMargin( InValue.X, InValue.Y, InValue.Z, InValue.W );
+			break;
+		default:
+			break;
+	}
+}
+
+// The only parameter of a function, if it has exactly one and nothing is returned
+static const FProperty* GetSingleParam( const UFunction* pFunction )
+{
+	const FProperty* pParam = nullptr;
+	for ( TFieldIterator<FProperty> It( pFunction ); It && It->HasAnyPropertyFlags( CPF_Parm ); ++It )
+	{
+		// Const references are flagged as out params too
+		const bool bIsOutput = It->HasAnyPropertyFlags( CPF_ReturnParm ) || ( It->HasAnyPropertyFlags( CPF_OutParm ) && !It->HasAnyPropertyFlags( CPF_ConstParm ) );
+		if ( pParam || bIsOutput )
+		{
+			return nullptr;
+		}
+		pParam = *It;
+	}
+	return pParam;
+}
+
+
+FBUITweenPropertyBinding FBUITweenPropertyBinding::Find( UClass* pClass, FName InPath )
+{
+	check( IsInGameThread() );
+
+	// Keyed by object key so a class that's been unloaded or recompiled resolves again
+	static TMap< TPair< FObjectKey, FName >, FBUITweenPropertyBinding > Bindings;
+
+	const TPair< FObjectKey, FName > Key( FObjectKey( pClass ), InPath );
+	if ( const FBUITweenPropertyBinding* pFound = Bindings.Find( Key ) )
+	{
+		return *pFound;
+	}
+
+	const FBUITweenPropertyBinding Binding = Resolve( pClass, InPath );
+	if ( !Binding.IsValid() )
+	{
+		UE_LOG( LogBUITween, Warning, TEXT( "%s has no float, FVector2D, FLinearColor or FMargin property or setter at %s" ), *GetNameSafe( pClass ), *InPath.ToString() );
+	}
+	Bindings.Add( Key, Binding );
+	return Binding;
+}
+
+
+FBUITweenPropertyBinding FBUITweenPropertyBinding::Resolve( UClass* pClass, FName InPath )
+{
+	FBUITweenPropertyBinding Binding;
+	if ( !pClass || InPath.IsNone() )
+	{
+		return Binding;
+	}
+
+	TArray< FString > Parts;
+	InPath.ToString().ParseIntoArray( Parts, TEXT( "." ) );
+
+	// Walk down through the struct members, adding up their offsets
+	const UStruct* pStruct = pClass;
+	const FProperty* pProperty = nullptr;
+	int32 Offset = 0;
+	for ( int32 i = 0; i < Parts.Num() && pStruct; ++i )
+	{
+		pProperty = FindFProperty<FProperty>( pStruct, *Parts[ i ] );
+		if ( !pProperty )
+		{
+			break;
+		}
+		Offset += pProperty->GetOffset_ForInternal();
+
+		const FStructProperty* pStructProperty = CastField<FStructProperty>( pProperty );
+		pStruct = i + 1 < Parts.Num() && pStructProperty ? pStructProperty->Struct : nullptr;
+		if ( i + 1 < Parts.Num() && !pStruct )
+		{
+			pProperty = nullptr;
+		}
+	}
+
+	if ( pProperty )
+	{
+		Binding.Type = GetPropertyType( pProperty );
+		Binding.Offset = Binding.Type != EBUITweenPropertyType::None ? Offset : INDEX_NONE;
+	}
+
+	// A setter named by the path itself, or Set<Name> for a property on the class
+	UFunction* pSetter = nullptr;
+	if ( Parts.Num() == 1 )
+	{
+		pSetter = pClass->FindFunctionByName( InPath );
+		if ( !pSetter && pProperty )
+		{
+			pSetter = pClass->FindFunctionByName( *( TEXT( "Set" ) + Parts[ 0 ] ) );
+		}
+		else if ( pSetter && !pProperty && Parts[ 0 ].StartsWith( TEXT( "Set" ) ) )
+		{
+			// The property the setter writes, if there is one, gives the start value
+			pProperty = FindFProperty<FProperty>( pClass, *Parts[ 0 ].RightChop( 3 ) );
+			const EBUITweenPropertyType PropertyType = pProperty ? GetPropertyType( pProperty ) : EBUITweenPropertyType::None;
+			Binding.Offset = PropertyType != EBUITweenPropertyType::None ? pProperty->GetOffset_ForInternal() : INDEX_NONE;
+			Binding.Type = PropertyType;
+		}
+	}
+
+	const FProperty* pParam = pSetter ? GetSingleParam( pSetter ) : nullptr;
+	const EBUITweenPropertyType ParamType = pParam ? GetPropertyType( pParam ) : EBUITweenPropertyType::None;
+	if ( ParamType != EBUITweenPropertyType::None && pSetter->ParmsSize <= MaxSetterParamsSize
+		&& ( Binding.Type == EBUITweenPropertyType::None || Binding.Type == ParamType ) )
+	{
+		Binding.pSetter = pSetter;
+		Binding.SetterParamOffset = pParam->GetOffset_ForUFunction();
+		Binding.Type = ParamType;
+	}
+	else if ( !Binding.IsReadable() )
+	{
+		Binding.Type = EBUITweenPropertyType::None;
+	}
+
+	return Binding;
+}
+
+
+bool FBUITweenPropertyBinding::Read( const UWidget* pWidget, FVector4& OutValue ) const
+{
+	if ( !IsReadable() )
+	{
+		return false;
+	}
+
+	const uint8* pSource = reinterpret_cast<const uint8*>( pWidget ) + Offset;
+	switch ( Type )
+	{
+		case EBUITweenPropertyType::Float:
+			OutValue = FVector4( *reinterpret_cast<const float*>( pSource ), 0, 0, 0 );
+			return true;
+		case EBUITweenPropertyType::Double:
+			OutValue = FVector4( *reinterpret_cast<const double*>( pSource ), 0, 0, 0 );
+			return true;
+		case EBUITweenPropertyType::Vector2D:
+		{
+			const FVector2D& Value = *reinterpret_cast<const FVector2D*>( pSource );
+			OutValue = FVector4( Value.X, Value.Y, 0, 0 );
+			return true;
+		}
+		case EBUITweenPropertyType::LinearColor:
+		{
+			const FLinearColor& Value = *reinterpret_cast<const FLinearColor*>( pSource );
+			OutValue = FVector4( Value.R, Value.G, Value.B, Value.A );
+			return true;
+		}
+		case EBUITweenPropertyType::Margin:
+		{
+			const FMargin& Value = *reinterpret_cast<const FMargin*>( pSource );
+			OutValue = FVector4( Value.Left, Value.Top, Value.Right, Value.Bottom );
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+
+void FBUITweenPropertyBinding::Write( UWidget* pWidget, const FVector4& InValue ) const
+{
+	if ( pSetter )
+	{
+		alignas( 16 ) uint8 Params[ MaxSetterParamsSize ] = { 0 };
+		StoreValue( Type, Params + SetterParamOffset, InValue );
+		pWidget->ProcessEvent( pSetter, Params );
+		return;
+	}
+
+	// UMG only copies its properties to the Slate widget when it synchronizes them, invalidating isn't enough
+	StoreValue( Type, reinterpret_cast<uint8*>( pWidget ) + Offset, InValue );
+	if ( pWidget->GetCachedWidget().IsValid() )
+	{
+		pWidget->SynchronizeProperties();
+	}
+}
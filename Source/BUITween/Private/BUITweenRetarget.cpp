@@ -0,0 +1,88 @@
+#include "BUITweenRetarget.h"
+#include "BUITweenStorage.h"
+
+bool FBUITweenRetarget::IsValid() const
+{
+	return pStorage && pStorage->IsTweening( Handle );
+}
+
+
+bool FBUITweenRetarget::Rebase()
+{
+	if ( !bIsRebased )
+	{
+		bIsRebased = pStorage && pStorage->Rebase( Handle );
+	}
+	return bIsRebased;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::ToTranslation( const FVector2D& InTarget )
+{
+	bSucceeded &= Rebase() && pStorage->RetargetChannel( Handle, EBUITweenChannel::Translation, pStorage->TranslationChannel, &FBUITweenInstance::TranslationProp, InTarget );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::ToScale( const FVector2D& InTarget )
+{
+	bSucceeded &= Rebase() && pStorage->RetargetChannel( Handle, EBUITweenChannel::Scale, pStorage->ScaleChannel, &FBUITweenInstance::ScaleProp, InTarget );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::ToRotation( float InTarget )
+{
+	bSucceeded &= Rebase() && pStorage->RetargetChannel( Handle, EBUITweenChannel::Rotation, pStorage->RotationChannel, &FBUITweenInstance::RotationProp, InTarget );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::ToOpacity( float InTarget )
+{
+	bSucceeded &= Rebase() && pStorage->RetargetChannel( Handle, EBUITweenChannel::Opacity, pStorage->OpacityChannel, &FBUITweenInstance::OpacityProp, InTarget );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::ToColor( const FLinearColor& InTarget )
+{
+	bSucceeded &= Rebase() && pStorage->RetargetChannel( Handle, EBUITweenChannel::Color, pStorage->ColorChannel, &FBUITweenInstance::ColorProp, InTarget );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::ToCanvasPosition( const FVector2D& InTarget )
+{
+	bSucceeded &= Rebase() && pStorage->RetargetChannel( Handle, EBUITweenChannel::CanvasPosition, pStorage->CanvasPositionChannel, &FBUITweenInstance::CanvasPositionProp, InTarget );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::ToPadding( const FMargin& InTarget )
+{
+	const FVector4 Padding( InTarget.Left, InTarget.Top, InTarget.Right, InTarget.Bottom );
+	bSucceeded &= Rebase() && pStorage->RetargetChannel( Handle, EBUITweenChannel::Padding, pStorage->PaddingChannel, &FBUITweenInstance::PaddingProp, Padding );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::ToMaxDesiredHeight( float InTarget )
+{
+	bSucceeded &= Rebase() && pStorage->RetargetChannel( Handle, EBUITweenChannel::MaxDesiredHeight, pStorage->MaxDesiredHeightChannel, &FBUITweenInstance::MaxDesiredHeightProp, InTarget );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::Duration( float InDuration )
+{
+	bSucceeded &= Rebase() && pStorage->SetDuration( Handle, InDuration );
+	return *this;
+}
+
+
+FBUITweenRetarget& FBUITweenRetarget::Easing( EBUIEasingType InType, TOptional<float> InEasingParam )
+{
+	bSucceeded &= Rebase() && pStorage->SetEasing( Handle, InType, InEasingParam );
+	return *this;
+}
@@ -0,0 +1,167 @@
+#include "BUITweenSequence.h"
+#include "BUITweenStorage.h"
+
+FBUITweenInstance& FBUITweenSequence::Append( UWidget* pInWidget, float InDuration )
+{
+	LastAppendTime = Duration;
+	return AddStep( LastAppendTime, pInWidget, InDuration );
+}
+
+
+FBUITweenInstance& FBUITweenSequence::Join( UWidget* pInWidget, float InDuration )
+{
+	return AddStep( LastAppendTime, pInWidget, InDuration );
+}
+
+
+FBUITweenInstance& FBUITweenSequence::Insert( float InTime, UWidget* pInWidget, float InDuration )
+{
+	return AddStep( FMath::Max( InTime, 0.0f ), pInWidget, InDuration );
+}
+
+
+FBUITweenSequence& FBUITweenSequence::AppendInterval( float InInterval )
+{
+	Duration += FMath::Max( InInterval, 0.0f );
+	return *this;
+}
+
+
+FBUITweenSequence& FBUITweenSequence::OnStart( const FBUITweenSignature& InOnStart )
+{
+	pOwner->OnStart( InOnStart );
+	return *this;
+}
+
+
+FBUITweenSequence& FBUITweenSequence::OnComplete( const FBUITweenSignature& InOnComplete )
+{
+	pOwner->OnComplete( InOnComplete );
+	return *this;
+}
+
+
+FBUITweenHandle FBUITweenSequence::GetHandle() const
+{
+	return pOwner->GetHandle();
+}
+
+
+FBUITweenInstance& FBUITweenSequence::AddStep( float InStartTime, UWidget* pInWidget, float InDuration )
+{
+	InDuration = FMath::Max( InDuration, 0.0f );
+
+	FStep* Step = new FStep();
+	Step->Instance = FBUITweenInstance( pInWidget, InDuration );
+	Step->StartTime = InStartTime;
+	Steps.Add( Step );
+
+	Duration = FMath::Max( Duration, InStartTime + InDuration );
+	return Step->Instance;
+}
+
+
+void FBUITweenSequence::Begin()
+{
+	const FBUITweenStorage* Storage = FBUITweenStorage::FindById( pOwner->Handle.StorageId );
+	if ( !ensureMsgf( Storage && Storage->IsPending( pOwner->Handle ), TEXT( "Sequences can only be begun before their first update, create a new one to restart" ) ) )
+	{
+		return;
+	}
+
+	Keyframes.Reset( Steps.Num() * 2 );
+	for ( int32 StepIndex = 0; StepIndex < Steps.Num(); ++StepIndex )
+	{
+		FStep& Step = Steps[ StepIndex ];
+		Keyframes.Add( { Step.StartTime, StepIndex, true } );
+		Keyframes.Add( { Step.StartTime + Step.Instance.Duration, StepIndex, false } );
+
+		// The casts happen once here, each step only reads its start values when it starts
+		Step.Instance.Targets.Resolve( Step.Instance.pWidget.Get() );
+		Step.bIsActive = false;
+		Step.bIsDone = false;
+	}
+
+	// Ends come before starts at the same time, so a step appended after another starts from its final value
+	Keyframes.StableSort( []( const FKeyframe& A, const FKeyframe& B )
+	{
+		return A.Time < B.Time || ( A.Time == B.Time && !A.bIsStart && B.bIsStart );
+	} );
+
+	Cursor = 0;
+	ActiveSteps.Reset();
+
+	pOwner->Duration = Duration;
+	pOwner->bShouldUpdate = true;
+}
+
+
+void FBUITweenSequence::Advance( float Time, FBUITweenStorage& Storage )
+{
+	while ( Cursor < Keyframes.Num() && Keyframes[ Cursor ].Time <= Time )
+	{
+		const FKeyframe& Keyframe = Keyframes[ Cursor++ ];
+		FStep& Step = Steps[ Keyframe.StepIndex ];
+		if ( Step.bIsDone )
+		{
+			continue;
+		}
+
+		if ( Keyframe.bIsStart )
+		{
+			StartStep( Keyframe.StepIndex, Storage );
+			continue;
+		}
+
+		// A zero length step has its end sorted before its start
+		if ( !Step.bIsActive )
+		{
+			StartStep( Keyframe.StepIndex, Storage );
+		}
+		if ( Step.bIsActive )
+		{
+			ApplyStep( Step, Keyframe.Time, Storage );
+			ActiveSteps.RemoveSingle( Keyframe.StepIndex );
+			Step.bIsActive = false;
+		}
+		Step.bIsDone = true;
+		Storage.QueueEvent( pOwner->Handle, EBUITweenEvent::Complete, Keyframe.StepIndex );
+	}
+
+	for ( int32 StepIndex : ActiveSteps )
+	{
+		ApplyStep( Steps[ StepIndex ], Time, Storage );
+	}
+}
+
+
+void FBUITweenSequence::StartStep( int32 StepIndex, FBUITweenStorage& Storage )
+{
+	FStep& Step = Steps[ StepIndex ];
+	if ( !Step.Instance.pWidget.IsValid() )
+	{
+		return;
+	}
+
+	Step.Instance.CaptureStartValues();
+	Step.bIsActive = true;
+	ActiveSteps.Add( StepIndex );
+	Storage.QueueEvent( pOwner->Handle, EBUITweenEvent::Start, StepIndex );
+}
+
+
+void FBUITweenSequence::ApplyStep( FStep& Step, float Time, FBUITweenStorage& Storage )
+{
+	UWidget* pWidget = Step.Instance.pWidget.Get();
+	if ( !pWidget )
+	{
+		return;
+	}
+
+	const FBUITweenInstance& Instance = Step.Instance;
+	const float LocalTime = FMath::Clamp( Time - Step.StartTime, 0.0f, Instance.Duration );
+	const float EasedAlpha = Instance.Duration > 0
+		? FBUIEasing::Ease( Instance.EasingType, LocalTime, Instance.Duration, Instance.EasingParam.Get( FBUIEasing::DefaultParam ) )
+		: 1.0f;
+	Step.Instance.Apply( EasedAlpha, &Storage.FindOrAddWidgetWrite( pWidget ) );
+}
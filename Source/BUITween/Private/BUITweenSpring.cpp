@@ -0,0 +1,54 @@
+#include "BUITweenSpring.h"
+
+// How far from 1 the damping ratio may be and still be solved as critically damped
+static const float CriticalTolerance = 0.0001f;
+
+FBUITweenSpring::FStep FBUITweenSpring::Step( float DeltaTime ) const
+{
+	const float SafeMass = FMath::Max( Mass, KINDA_SMALL_NUMBER );
+	const float SafeStiffness = FMath::Max( Stiffness, KINDA_SMALL_NUMBER );
+	const float Omega = FMath::Sqrt( SafeStiffness / SafeMass );
+	const float Zeta = FMath::Max( Damping, 0.0f ) / ( 2 * FMath::Sqrt( SafeStiffness * SafeMass ) );
+	const float T = FMath::Max( DeltaTime, 0.0f );
+
+	FStep Result;
+	if ( Zeta < 1 - CriticalTolerance )
+	{
+		// Under damped, oscillates around the target while it decays
+		const float DampedOmega = Omega * FMath::Sqrt( 1 - Zeta * Zeta );
+		const float Decay = FMath::Exp( -Zeta * Omega * T );
+		const float Cos = FMath::Cos( DampedOmega * T );
+		const float Sin = FMath::Sin( DampedOmega * T );
+		const float ZetaOmega = Zeta * Omega;
+
+		Result.YY = Decay * ( Cos + ZetaOmega / DampedOmega * Sin );
+		Result.YV = Decay * Sin / DampedOmega;
+		Result.VY = -Decay * Sin * Omega * Omega / DampedOmega;
+		Result.VV = Decay * ( Cos - ZetaOmega / DampedOmega * Sin );
+	}
+	else if ( Zeta > 1 + CriticalTolerance )
+	{
+		// Over damped, two decaying exponentials
+		const float Root = FMath::Sqrt( Zeta * Zeta - 1 );
+		const float R1 = -Omega * ( Zeta - Root );
+		const float R2 = -Omega * ( Zeta + Root );
+		const float E1 = FMath::Exp( R1 * T );
+		const float E2 = FMath::Exp( R2 * T );
+		const float InvDiff = 1 / ( R2 - R1 );
+
+		Result.YY = ( R2 * E1 - R1 * E2 ) * InvDiff;
+		Result.YV = ( E2 - E1 ) * InvDiff;
+		Result.VY = R1 * R2 * ( E1 - E2 ) * InvDiff;
+		Result.VV = ( R2 * E2 - R1 * E1 ) * InvDiff;
+	}
+	else
+	{
+		const float Decay = FMath::Exp( -Omega * T );
+
+		Result.YY = ( 1 + Omega * T ) * Decay;
+		Result.YV = T * Decay;
+		Result.VY = -Omega * Omega * T * Decay;
+		Result.VV = ( 1 - Omega * T ) * Decay;
+	}
+	return Result;
+}
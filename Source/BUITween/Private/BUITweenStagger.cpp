@@ -0,0 +1,285 @@
+#include "BUITweenStagger.h"
+#include "BUITweenStorage.h"
+
+void FBUITweenStagger::Init( TArrayView<UWidget* const> InWidgets, float InDuration, float InStaggerInterval )
+{
+	ElementDuration = FMath::Max( InDuration, 0.0f );
+	Interval = FMath::Abs( InStaggerInterval );
+
+	Elements.Reset( InWidgets.Num() );
+	for ( int32 i = 0; i < InWidgets.Num(); ++i )
+	{
+		UWidget* pWidget = InWidgets[ InStaggerInterval < 0 ? InWidgets.Num() - 1 - i : i ];
+		if ( !pWidget )
+		{
+			continue;
+		}
+
+		FElement& Element = Elements.AddDefaulted_GetRef();
+		Element.pWidget = pWidget;
+		Element.WidgetKey = FObjectKey( pWidget );
+		Element.StartTime = ( Elements.Num() - 1 ) * Interval;
+	}
+}
+
+
+float FBUITweenStagger::GetDuration() const
+{
+	return Elements.Num() > 0 ? Elements.Last().StartTime + ElementDuration : 0;
+}
+
+
+bool FBUITweenStagger::StopElement( const FObjectKey& WidgetKey )
+{
+	bool bWasPlaying = false;
+	for ( int32 i = FirstRunning; i < Elements.Num(); ++i )
+	{
+		FElement& Element = Elements[ i ];
+		if ( Element.WidgetKey == WidgetKey && !Element.bIsStopped )
+		{
+			Element.bIsStopped = true;
+			bWasPlaying = true;
+		}
+	}
+	return bWasPlaying;
+}
+
+
+void FBUITweenStagger::Begin( const FBUITweenInstance& Shared )
+{
+	const int32 Num = Elements.Num();
+	auto ResetStarts = [ Num ]( auto& Starts, const auto& Prop )
+	{
+		Starts.Reset();
+		if ( Prop.IsSet() )
+		{
+			Starts.Init( Prop.StartValue, Num );
+		}
+	};
+
+	ResetStarts( TranslationStarts, Shared.TranslationProp );
+	ResetStarts( ScaleStarts, Shared.ScaleProp );
+	ResetStarts( RotationStarts, Shared.RotationProp );
+	ResetStarts( OpacityStarts, Shared.OpacityProp );
+	ResetStarts( ColorStarts, Shared.ColorProp );
+	ResetStarts( VisibilityStarts, Shared.VisibilityProp );
+	ResetStarts( CanvasPositionStarts, Shared.CanvasPositionProp );
+	ResetStarts( PaddingStarts, Shared.PaddingProp );
+	ResetStarts( MaxDesiredHeightStarts, Shared.MaxDesiredHeightProp );
+
+	const bool bNeedsTargets = Shared.ColorProp.IsSet() || Shared.CanvasPositionProp.IsSet() || Shared.PaddingProp.IsSet() || Shared.MaxDesiredHeightProp.IsSet();
+
+	for ( int32 i = 0; i < Num; ++i )
+	{
+		FElement& Element = Elements[ i ];
+		UWidget* pWidget = Element.pWidget.Get();
+		if ( !pWidget )
+		{
+			continue;
+		}
+
+		if ( bNeedsTargets )
+		{
+			Element.Targets.Resolve( pWidget );
+		}
+
+		// Same rules as CaptureStartValues(), a From value wins over the widget's current state
+		const FWidgetTransform& CurrentTransform = pWidget->GetRenderTransform();
+		if ( Shared.TranslationProp.IsSet() && !Shared.TranslationProp.bHasStart )
+		{
+			TranslationStarts[ i ] = CurrentTransform.Translation;
+		}
+		if ( Shared.ScaleProp.IsSet() && !Shared.ScaleProp.bHasStart )
+		{
+			ScaleStarts[ i ] = CurrentTransform.Scale;
+		}
+		if ( Shared.RotationProp.IsSet() && !Shared.RotationProp.bHasStart )
+		{
+			RotationStarts[ i ] = CurrentTransform.Angle;
+		}
+		if ( Shared.OpacityProp.IsSet() && !Shared.OpacityProp.bHasStart )
+		{
+			OpacityStarts[ i ] = pWidget->GetRenderOpacity();
+		}
+		if ( Shared.VisibilityProp.IsSet() && !Shared.VisibilityProp.bHasStart )
+		{
+			VisibilityStarts[ i ] = pWidget->GetVisibility();
+		}
+		if ( Shared.ColorProp.IsSet() && !Shared.ColorProp.bHasStart )
+		{
+			Element.Targets.GetColor( pWidget, ColorStarts[ i ] );
+		}
+		if ( Shared.CanvasPositionProp.IsSet() && !Shared.CanvasPositionProp.bHasStart )
+		{
+			Element.Targets.GetCanvasPosition( pWidget, CanvasPositionStarts[ i ] );
+		}
+		FMargin CurrentPadding;
+		if ( Shared.PaddingProp.IsSet() && !Shared.PaddingProp.bHasStart && Element.Targets.GetPadding( pWidget, CurrentPadding ) )
+		{
+			PaddingStarts[ i ] = FVector4( CurrentPadding.Left, CurrentPadding.Top, CurrentPadding.Right, CurrentPadding.Bottom );
+		}
+		if ( Shared.MaxDesiredHeightProp.IsSet() && !Shared.MaxDesiredHeightProp.bHasStart )
+		{
+			Element.Targets.GetMaxDesiredHeight( pWidget, MaxDesiredHeightStarts[ i ] );
+		}
+
+		// Apply the starting conditions to every element, even the ones that start late
+		ApplyElement( Shared, i, 0 );
+	}
+
+	FirstRunning = 0;
+	NumStarted = 0;
+}
+
+
+void FBUITweenStagger::Advance( const FBUITweenInstance& Shared, float Time, FBUITweenStorage& Storage )
+{
+	while ( NumStarted < Elements.Num() && Elements[ NumStarted ].StartTime <= Time )
+	{
+		++NumStarted;
+	}
+
+	const float Param = Shared.EasingParam.Get( FBUIEasing::DefaultParam );
+	for ( int32 i = FirstRunning; i < NumStarted; ++i )
+	{
+		const float LocalTime = Time - Elements[ i ].StartTime;
+		const bool bIsDone = LocalTime >= ElementDuration;
+		const float EasedAlpha = bIsDone ? 1.0f : FBUIEasing::Ease( Shared.EasingType, LocalTime, ElementDuration, Param );
+
+		UWidget* pWidget = Elements[ i ].pWidget.Get();
+		if ( pWidget && !Elements[ i ].bIsStopped )
+		{
+			ApplyElement( Shared, i, EasedAlpha, &Storage.FindOrAddWidgetWrite( pWidget ) );
+		}
+
+		// Everything before a finished element has finished too
+		if ( bIsDone )
+		{
+			FirstRunning = i + 1;
+		}
+	}
+}
+
+
+void FBUITweenStagger::ApplyElement( const FBUITweenInstance& Shared, int32 Index, float EasedAlpha, FBUITweenWidgetWrite* pWrite )
+{
+	FElement& Element = Elements[ Index ];
+	UWidget* pWidget = Element.pWidget.Get();
+	if ( !pWidget || Element.bIsStopped )
+	{
+		return;
+	}
+
+	// A prop with only a From value holds still. Keys are shared by every element at a different time, so
+	// each evaluation walks them from the start, they're only ever a handful.
+	auto Lerp = [ EasedAlpha ]( const auto& Prop, const auto& Start )
+	{
+		int32 KeyCursor = 0;
+		return Prop.Keys.Num() > 0 ? Prop.Keys.Evaluate( Start, EasedAlpha, KeyCursor )
+			: Prop.bHasTarget ? FMath::Lerp( Start, Prop.TargetValue, EasedAlpha ) : Start;
+	};
+
+	// Elements keep no last applied value, so each one is compared with what the widget has, or is about to
+	if ( Shared.ColorProp.IsSet() )
+	{
+		const FLinearColor Color = Lerp( Shared.ColorProp, ColorStarts[ Index ] );
+		const bool bIsQueued = pWrite && pWrite->pColorTargets;
+		FLinearColor CurrentColor = bIsQueued ? pWrite->Color : FLinearColor::Transparent;
+		const bool bHasCurrent = bIsQueued || Element.Targets.GetColor( pWidget, CurrentColor );
+		if ( !bHasCurrent || Color != CurrentColor )
+		{
+			if ( pWrite )
+			{
+				pWrite->Color = Color;
+				pWrite->pColorTargets = &Element.Targets;
+			}
+			else
+			{
+				Element.Targets.SetColor( pWidget, Color );
+			}
+		}
+	}
+	if ( Shared.OpacityProp.IsSet() )
+	{
+		const float Opacity = Lerp( Shared.OpacityProp, OpacityStarts[ Index ] );
+		const float CurrentOpacity = pWrite && pWrite->bHasOpacity ? pWrite->Opacity : pWidget->GetRenderOpacity();
+		if ( Opacity != CurrentOpacity && pWrite )
+		{
+			pWrite->Opacity = Opacity;
+			pWrite->bHasOpacity = true;
+		}
+		else if ( Opacity != CurrentOpacity )
+		{
+			pWidget->SetRenderOpacity( Opacity );
+		}
+	}
+
+	// Only apply visibility changes at 0 or 1
+	if ( Shared.VisibilityProp.IsSet() && ( EasedAlpha <= 0 || EasedAlpha >= 1 ) )
+	{
+		const ESlateVisibility Visibility = EasedAlpha >= 1 && Shared.VisibilityProp.bHasTarget ? Shared.VisibilityProp.TargetValue : VisibilityStarts[ Index ];
+		if ( Visibility != pWidget->GetVisibility() )
+		{
+			pWidget->SetVisibility( Visibility );
+		}
+	}
+
+	if ( Shared.TranslationProp.IsSet() || Shared.ScaleProp.IsSet() || Shared.RotationProp.IsSet() )
+	{
+		const FWidgetTransform CurrentTransform = pWrite && pWrite->bHasTransform ? pWrite->Transform : pWidget->GetRenderTransform();
+		FWidgetTransform Transform = CurrentTransform;
+		if ( Shared.TranslationProp.IsSet() )
+		{
+			Transform.Translation = Lerp( Shared.TranslationProp, TranslationStarts[ Index ] );
+		}
+		if ( Shared.ScaleProp.IsSet() )
+		{
+			Transform.Scale = Lerp( Shared.ScaleProp, ScaleStarts[ Index ] );
+		}
+		if ( Shared.RotationProp.IsSet() )
+		{
+			Transform.Angle = Lerp( Shared.RotationProp, RotationStarts[ Index ] );
+		}
+		if ( Transform.Translation != CurrentTransform.Translation || Transform.Scale != CurrentTransform.Scale || Transform.Angle != CurrentTransform.Angle )
+		{
+			if ( pWrite )
+			{
+				pWrite->Transform = Transform;
+				pWrite->bHasTransform = true;
+			}
+			else
+			{
+				pWidget->SetRenderTransform( Transform );
+			}
+		}
+	}
+
+	if ( Shared.CanvasPositionProp.IsSet() )
+	{
+		const FVector2D Position = Lerp( Shared.CanvasPositionProp, CanvasPositionStarts[ Index ] );
+		FVector2D CurrentPosition;
+		if ( !Element.Targets.GetCanvasPosition( pWidget, CurrentPosition ) || Position != CurrentPosition )
+		{
+			Element.Targets.SetCanvasPosition( pWidget, Position );
+		}
+	}
+	if ( Shared.PaddingProp.IsSet() )
+	{
+		const FVector4 Padding = Lerp( Shared.PaddingProp, PaddingStarts[ Index ] );
+		const FMargin Margin( Padding.X, Padding.Y, Padding.Z, Padding.W );
+		FMargin CurrentMargin;
+		if ( !Element.Targets.GetPadding( pWidget, CurrentMargin ) || Margin != CurrentMargin )
+		{
+			Element.Targets.SetPadding( pWidget, Margin );
+		}
+	}
+	if ( Shared.MaxDesiredHeightProp.IsSet() )
+	{
+		const float Height = Lerp( Shared.MaxDesiredHeightProp, MaxDesiredHeightStarts[ Index ] );
+		float CurrentHeight;
+		if ( !Element.Targets.GetMaxDesiredHeight( pWidget, CurrentHeight ) || Height != CurrentHeight )
+		{
+			Element.Targets.SetMaxDesiredHeight( pWidget, Height );
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+// "stat BUITween" in game, or run with -trace=cpu,counters,BUITween to see the tween scopes in Unreal Insights
+
+DECLARE_STATS_GROUP( TEXT( "BUITween" ), STATGROUP_BUITween, STATCAT_Advanced );
+
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Update" ), STAT_BUITween_Update, STATGROUP_BUITween, );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Evaluate" ), STAT_BUITween_Evaluate, STATGROUP_BUITween, );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Cull" ), STAT_BUITween_Cull, STATGROUP_BUITween, );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Apply" ), STAT_BUITween_Apply, STATGROUP_BUITween, );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Callbacks" ), STAT_BUITween_Callbacks, STATGROUP_BUITween, );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Blueprint Callbacks" ), STAT_BUITween_BlueprintCallbacks, STATGROUP_BUITween, );
+DECLARE_CYCLE_STAT_EXTERN( TEXT( "Begin" ), STAT_BUITween_Begin, STATGROUP_BUITween, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN( TEXT( "Active Tweens" ), STAT_BUITween_NumActive, STATGROUP_BUITween, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN( TEXT( "Pending Tweens" ), STAT_BUITween_NumPending, STATGROUP_BUITween, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Started" ), STAT_BUITween_NumStarted, STATGROUP_BUITween, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Looped" ), STAT_BUITween_NumLooped, STATGROUP_BUITween, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Completed" ), STAT_BUITween_NumCompleted, STATGROUP_BUITween, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Widget Writes" ), STAT_BUITween_NumWrites, STATGROUP_BUITween, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Widget Writes Avoided" ), STAT_BUITween_NumWritesAvoided, STATGROUP_BUITween, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN( TEXT( "Culled" ), STAT_BUITween_NumCulled, STATGROUP_BUITween, );
+
+DECLARE_MEMORY_STAT_EXTERN( TEXT( "Header Memory" ), STAT_BUITween_HeaderMemory, STATGROUP_BUITween, );
+DECLARE_MEMORY_STAT_EXTERN( TEXT( "Channel Memory" ), STAT_BUITween_ChannelMemory, STATGROUP_BUITween, );
+DECLARE_MEMORY_STAT_EXTERN( TEXT( "Instance Memory" ), STAT_BUITween_InstanceMemory, STATGROUP_BUITween, );
+
+UE_TRACE_CHANNEL_EXTERN( BUITweenChannel );
+
+TRACE_DECLARE_INT_COUNTER_EXTERN( BUITween_NumActive );
+TRACE_DECLARE_INT_COUNTER_EXTERN( BUITween_NumWrites );
+
+// Cycle stat and Insights scope in one, the Insights one only shows when the BUITween trace channel is on
+#define BUITWEEN_SCOPE( Name ) \
+	SCOPE_CYCLE_COUNTER( STAT_BUITween_##Name ); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL( BUITween_##Name, BUITweenChannel )
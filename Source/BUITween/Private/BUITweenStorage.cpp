@@ -0,0 +1,2093 @@
+#include "BUITweenStorage.h"
+#include "BUITweenStats.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/ScrollBox.h"
+#include "Layout/ArrangedWidget.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Widgets/SWidget.h"
+
+// Entries per ParallelFor task, small enough that a few hundred tweens still spread over several workers
+static const int32 EvaluateChunkSize = 128;
+
+// Smallest change per channel worth invalidating a widget for, nothing under these shows up on screen.
+// The last frame of a tween ignores them so it still lands exactly on the target.
+static const float TranslationEpsilon = 0.01f;
+static const float ScaleEpsilon = 0.0001f;
+static const float RotationEpsilon = 0.01f;
+static const float OpacityEpsilon = 0.5f / 255.0f;
+static const float ColorEpsilon = 0.5f / 255.0f;
+static const float LayoutEpsilon = 0.01f;
+static const float MaterialEpsilon = 0.001f;
+static const float PropertyEpsilon = 0.001f;
+
+template<typename T>
+static inline bool IsWithinEpsilon( const T& A, const T& B, float Epsilon )
+{
+	return A.Equals( B, Epsilon );
+}
+
+static inline bool IsWithinEpsilon( float A, float B, float Epsilon )
+{
+	return FMath::IsNearlyEqual( A, B, Epsilon );
+}
+
+template<typename T>
+static const TBUITweenKeys<T>* GetKeys( const TBUITweenProp<T>& Prop )
+{
+	return Prop.Keys.Num() > 0 ? &Prop.Keys : nullptr;
+}
+
+template<typename T>
+static const TBUITweenKeys<T>* GetKeys( const TBUITweenInstantProp<T>& Prop )
+{
+	return nullptr;
+}
+
+// Tables are built when a tween gets its easing or duration and kept on the header, so the update doesn't
+// look them up at all
+static void PrepareEasingTable( FBUITweenHeader& Header )
+{
+	FBUIEasingLUT& EasingLUT = FBUIEasingLUT::Get();
+	const bool bUsesTable = EasingLUT.IsEnabled() && !Header.bIsSpring && !Header.bIsGroup;
+	Header.pEasingTable = bUsesTable ? EasingLUT.FindOrBuild( Header.EasingType, Header.Duration, Header.bHasEasingParam ? Header.EasingParam : FBUIEasing::DefaultParam ) : nullptr;
+	Header.EasingTableGeneration = EasingLUT.GetGeneration();
+}
+
+// How fast the eased alpha leaves 0, per second. A rebased tween's velocity term only makes up the
+// difference, so its curve still leaves at the speed it carries whatever the easing.
+static void PrepareEaseStartSlope( FBUITweenHeader& Header )
+{
+	Header.EaseStartSlope = 0;
+	if ( Header.bCarriesVelocity && Header.Duration > 0 )
+	{
+		const float Param = Header.bHasEasingParam ? Header.EasingParam : FBUIEasing::DefaultParam;
+		const float Step = Header.Duration * 0.001f;
+		Header.EaseStartSlope = ( FBUIEasing::Ease( Header.EasingType, Step, Header.Duration, Param ) - FBUIEasing::Ease( Header.EasingType, 0, Header.Duration, Param ) ) / Step;
+	}
+}
+
+static TAutoConsoleVariable<int32> CVarBUITweenParallelEvaluate(
+	TEXT( "BUITween.ParallelEvaluate" ),
+	1,
+	TEXT( "If non-zero the tween evaluate phase is spread across worker threads, otherwise it runs on the game thread." ) );
+
+static TAutoConsoleVariable<int32> CVarBUITweenCullHidden(
+	TEXT( "BUITween.CullHidden" ),
+	0,
+	TEXT( "If non-zero tweens skip their widget writes while the widget isn't rendered, unless they call CullWhenHidden( false )." ) );
+
+// Every live storage by id, so a handle can find the storage that made it
+static TMap< uint32, FBUITweenStorage* >& GetRegisteredStorages()
+{
+	static TMap< uint32, FBUITweenStorage* > Storages;
+	return Storages;
+}
+
+static uint32 AllocateStorageId()
+{
+	check( IsInGameThread() );
+
+	static uint32 NextId = 1;
+	return NextId++;
+}
+
+
+FBUITweenStorage::FBUITweenStorage()
+{
+	Id = AllocateStorageId();
+	GetRegisteredStorages().Add( Id, this );
+}
+
+
+FBUITweenStorage::~FBUITweenStorage()
+{
+	GetRegisteredStorages().Remove( Id );
+}
+
+
+FBUITweenStorage* FBUITweenStorage::FindById( uint32 InId )
+{
+	FBUITweenStorage** Found = GetRegisteredStorages().Find( InId );
+	return Found ? *Found : nullptr;
+}
+
+
+const TMap< uint32, FBUITweenStorage* >& FBUITweenStorage::GetAll()
+{
+	return GetRegisteredStorages();
+}
+
+
+FBUITweenInstance& FBUITweenStorage::Create( UWidget* pInWidget, float InDuration, float InDelay )
+{
+	const int32 SlotIndex = AllocateSlot();
+	FBUITweenSlot& Slot = Slots[ SlotIndex ];
+	Slot.Instance = FBUITweenInstance( pInWidget, InDuration, InDelay );
+	Slot.Instance.Handle = FBUITweenHandle( SlotIndex, Slot.Generation, Id );
+	Slot.WidgetKey = FObjectKey( pInWidget );
+
+	WidgetSlots.FindOrAdd( Slot.WidgetKey ).Add( SlotIndex );
+
+	PendingHandles.Add( Slot.Instance.Handle );
+
+	return Slot.Instance;
+}
+
+
+FBUITweenInstance& FBUITweenStorage::CreateSlate( const TSharedRef<SWidget>& InWidget, float InDuration, float InDelay )
+{
+	const int32 SlotIndex = AllocateSlot();
+	FBUITweenSlot& Slot = Slots[ SlotIndex ];
+	Slot.Instance = FBUITweenInstance( InWidget, InDuration, InDelay );
+	Slot.Instance.Handle = FBUITweenHandle( SlotIndex, Slot.Generation, Id );
+	Slot.WidgetKey = FObjectKey();
+	Slot.SlateWidgetKey = &InWidget.Get();
+
+	SlateWidgetSlots.FindOrAdd( Slot.SlateWidgetKey ).Add( SlotIndex );
+
+	PendingHandles.Add( Slot.Instance.Handle );
+
+	return Slot.Instance;
+}
+
+
+FBUITweenSequence& FBUITweenStorage::CreateSequence( float InDelay )
+{
+	// A sequence spans widgets, so it isn't in the widget index and Clear() leaves it alone
+	const int32 SlotIndex = AllocateSlot();
+	FBUITweenSlot& Slot = Slots[ SlotIndex ];
+	Slot.Instance = FBUITweenInstance();
+	Slot.Instance.Delay = InDelay;
+	Slot.Instance.Handle = FBUITweenHandle( SlotIndex, Slot.Generation, Id );
+	Slot.WidgetKey = FObjectKey();
+	Slot.Sequence = MakeUnique<FBUITweenSequence>();
+	Slot.Sequence->pOwner = &Slot.Instance;
+
+	PendingHandles.Add( Slot.Instance.Handle );
+
+	return *Slot.Sequence;
+}
+
+
+FBUITweenInstance& FBUITweenStorage::CreateStaggered( TArrayView<UWidget* const> InWidgets, float InDuration, float InStaggerInterval, float InDelay )
+{
+	const int32 SlotIndex = AllocateSlot();
+	FBUITweenSlot& Slot = Slots[ SlotIndex ];
+	Slot.Instance = FBUITweenInstance();
+	Slot.Instance.Duration = InDuration;
+	Slot.Instance.Delay = InDelay;
+	Slot.Instance.Handle = FBUITweenHandle( SlotIndex, Slot.Generation, Id );
+	Slot.WidgetKey = FObjectKey();
+	Slot.Stagger = MakeUnique<FBUITweenStagger>();
+	Slot.Stagger->Init( InWidgets, InDuration, InStaggerInterval );
+	Slot.Instance.pStagger = Slot.Stagger.Get();
+
+	// Listed under every element's widget, so a tween created on one of them later takes it over
+	for ( const FBUITweenStagger::FElement& Element : Slot.Stagger->Elements )
+	{
+		WidgetSlots.FindOrAdd( Element.WidgetKey ).AddUnique( SlotIndex );
+	}
+
+	PendingHandles.Add( Slot.Instance.Handle );
+
+	return Slot.Instance;
+}
+
+
+int32 FBUITweenStorage::AllocateSlot()
+{
+	int32 SlotIndex;
+	if ( FreeSlots.Num() > 0 )
+	{
+		SlotIndex = FreeSlots.Pop( false );
+	}
+	else
+	{
+		SlotIndex = Slots.Add( 1 );
+	}
+
+	FBUITweenSlot& Slot = Slots[ SlotIndex ];
+	Slot.State = EBUITweenSlotState::Pending;
+	Slot.HeaderIndex = INDEX_NONE;
+	return SlotIndex;
+}
+
+
+void FBUITweenStorage::Activate( int32 SlotIndex )
+{
+	const int32 Index = Headers.Num();
+
+	FBUITweenSlot& Slot = Slots[ SlotIndex ];
+	Slot.State = EBUITweenSlotState::Active;
+	Slot.HeaderIndex = Index;
+
+	const FBUITweenInstance& Instance = Slot.Instance;
+	FBUITweenHeader& Header = Headers.AddDefaulted_GetRef();
+	Header.pWidget = Instance.pWidget;
+	Header.SlotIndex = SlotIndex;
+	Header.bIsGroup = Slot.Sequence.IsValid() || Slot.Stagger.IsValid();
+	// A group's header is only its clock, the easing belongs to its steps or elements
+	Header.Duration = Slot.Stagger.IsValid() ? Slot.Stagger->GetDuration() : Instance.Duration;
+	Header.Delay = Instance.Delay;
+	Header.EasingType = Header.bIsGroup ? EBUIEasingType::Linear : Instance.EasingType;
+	Header.bHasEasingParam = Instance.EasingParam.IsSet();
+	Header.EasingParam = Instance.EasingParam.Get( 0 );
+	Header.bShouldUpdate = Instance.bShouldUpdate;
+	Header.bIsPaused = Instance.bIsPaused;
+	Header.bCullWhenHidden = Instance.bShouldCull.Get( CVarBUITweenCullHidden.GetValueOnGameThread() != 0 );
+	Header.bIsSpring = Instance.SpringParams.IsSet();
+	if ( Header.bIsSpring )
+	{
+		Header.SpringIndex = Springs.Add( { Index, Instance.SpringParams.GetValue(), {} } );
+	}
+	Header.bKeepAliveWhenSettled = Instance.bKeepAliveWhenSettled;
+	// A group's clock drives steps or elements that only run forward
+	const bool bCanLoop = !Header.bIsGroup && !Header.bIsSpring;
+	Header.LoopsLeft = bCanLoop ? ( Instance.NumCycles < 0 ? INDEX_NONE : FMath::Max( Instance.NumCycles - 1, 0 ) ) : 0;
+	Header.RepeatDelay = Instance.RepeatDelay;
+	Header.bIsPingPong = Instance.LoopType == EBUITweenLoopType::PingPong;
+	Header.bIsSlate = Instance.SlateWidget.IsValid();
+	PrepareEasingTable( Header );
+
+	if ( Header.bIsGroup )
+	{
+		return;
+	}
+
+	// A Slate widget only has a render transform and opacity to write to
+	const uint16 SupportedChannels = Header.bIsSlate
+		? ( 1 << static_cast<uint16>( EBUITweenChannel::Translation ) ) | ( 1 << static_cast<uint16>( EBUITweenChannel::Scale ) )
+			| ( 1 << static_cast<uint16>( EBUITweenChannel::Rotation ) ) | ( 1 << static_cast<uint16>( EBUITweenChannel::Opacity ) )
+		: MAX_uint16;
+
+	auto AddChannel = [ &Header, Index, SupportedChannels ]( EBUITweenChannel Channel, auto& Storage, const auto& Prop )
+	{
+		if ( Prop.IsSet() && ( SupportedChannels & ( 1 << static_cast<uint16>( Channel ) ) ) != 0 )
+		{
+			const auto* pKeys = GetKeys( Prop );
+			Header.ChannelMask |= 1 << static_cast<uint16>( Channel );
+			Header.ChannelIndices[ static_cast<int32>( Channel ) ] = Storage.Add( Index, Prop, pKeys );
+			Header.bHasKeys |= pKeys != nullptr;
+		}
+	};
+
+	AddChannel( EBUITweenChannel::Translation, TranslationChannel, Instance.TranslationProp );
+	AddChannel( EBUITweenChannel::Scale, ScaleChannel, Instance.ScaleProp );
+	AddChannel( EBUITweenChannel::Rotation, RotationChannel, Instance.RotationProp );
+	AddChannel( EBUITweenChannel::Opacity, OpacityChannel, Instance.OpacityProp );
+	AddChannel( EBUITweenChannel::Color, ColorChannel, Instance.ColorProp );
+	AddChannel( EBUITweenChannel::Visibility, VisibilityChannel, Instance.VisibilityProp );
+	AddChannel( EBUITweenChannel::CanvasPosition, CanvasPositionChannel, Instance.CanvasPositionProp );
+	AddChannel( EBUITweenChannel::Padding, PaddingChannel, Instance.PaddingProp );
+	AddChannel( EBUITweenChannel::MaxDesiredHeight, MaxDesiredHeightChannel, Instance.MaxDesiredHeightProp );
+
+	// Each appended as one run, leaving out what Begin() couldn't resolve
+	const int32 FirstMaterialParam = MaterialParameterChannel.Num();
+	for ( const FBUITweenMaterialParamProp& Param : Instance.MaterialParams )
+	{
+		if ( Param.ParameterIndex != INDEX_NONE && Instance.pMaterial.IsValid() && Header.NumMaterialParams < MAX_uint8 )
+		{
+			MaterialParameterChannel.Add( Index, Param, FBUITweenMaterialBinding{ Instance.pMaterial, Param.Name, Param.ParameterIndex, Param.bIsVector } );
+			++Header.NumMaterialParams;
+		}
+	}
+	if ( Header.NumMaterialParams > 0 )
+	{
+		Header.ChannelMask |= 1 << static_cast<uint16>( EBUITweenChannel::MaterialParameter );
+		Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::MaterialParameter ) ] = FirstMaterialParam;
+	}
+
+	const int32 FirstProperty = PropertyChannel.Num();
+	for ( const FBUITweenPropertyProp& Property : Instance.Properties )
+	{
+		if ( Property.Binding.IsValid() && Header.NumProperties < MAX_uint8 )
+		{
+			PropertyChannel.Add( Index, Property, Property.Binding );
+			++Header.NumProperties;
+		}
+	}
+	if ( Header.NumProperties > 0 )
+	{
+		Header.ChannelMask |= 1 << static_cast<uint16>( EBUITweenChannel::Property );
+		Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Property ) ] = FirstProperty;
+	}
+
+	if ( Header.bIsSpring && Instance.TranslationVelocity.IsSet() && Header.HasChannel( EBUITweenChannel::Translation ) )
+	{
+		TranslationChannel.Velocities[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Translation ) ] ] = Instance.TranslationVelocity.GetValue();
+	}
+
+	RefreshSharesWidget( Slot.WidgetKey );
+}
+
+
+void FBUITweenStorage::Update( float DeltaTime )
+{
+	if ( MaterialParameterChannel.NumDead > 0 )
+	{
+		MaterialParameterChannel.Compact( Headers );
+	}
+	if ( PropertyChannel.NumDead > 0 )
+	{
+		PropertyChannel.Compact( Headers );
+	}
+
+	bIsUpdating = true;
+
+	{
+		BUITWEEN_SCOPE( Evaluate );
+		Evaluate( DeltaTime );
+	}
+	{
+		BUITWEEN_SCOPE( Cull );
+		Cull();
+	}
+	{
+		BUITWEEN_SCOPE( Apply );
+		Apply();
+	}
+	INC_DWORD_STAT_BY( STAT_BUITween_NumCulled, ApplyStats.NumCulled );
+	INC_DWORD_STAT_BY( STAT_BUITween_NumWrites, ApplyStats.NumWrites );
+	INC_DWORD_STAT_BY( STAT_BUITween_NumWritesAvoided, ApplyStats.NumAvoided() );
+
+	// Reverse it so we can remove. The slots stay alive until their callbacks have run, because we don't
+	// know if the callback in the cleanup is going to trigger adding or clearing more tweens
+	for ( int32 i = Headers.Num() - 1; i >= 0; --i )
+	{
+		if ( Headers[ i ].bIsComplete )
+		{
+			const int32 SlotIndex = Headers[ i ].SlotIndex;
+			const bool bWasCancelled = Headers[ i ].bIsCancelled;
+			const FObjectKey WidgetKey = Slots[ SlotIndex ].WidgetKey;
+			Slots[ SlotIndex ].Instance.CompletionOverflow = Headers[ i ].Overflow;
+			RemoveAtSwap( i );
+
+			if ( bWasCancelled )
+			{
+				FreeSlot( SlotIndex );
+			}
+			else
+			{
+				Slots[ SlotIndex ].State = EBUITweenSlotState::Completing;
+				QueueEvent( SlotIndex, EBUITweenEvent::Complete );
+			}
+			RefreshSharesWidget( WidgetKey );
+		}
+	}
+
+	bIsUpdating = false;
+
+	if ( bDeferEvents )
+	{
+		ActivatePending();
+	}
+	else
+	{
+		DispatchEvents();
+	}
+}
+
+
+void FBUITweenStorage::DispatchEvents()
+{
+	check( !bIsUpdating );
+
+	// A callback that completes tweens queues more events, the outer dispatch picks them up once it's done
+	if ( bIsDispatching )
+	{
+		return;
+	}
+	bIsDispatching = true;
+
+	while ( Events.Num() > 0 )
+	{
+		BUITWEEN_SCOPE( Callbacks );
+		Swap( Events, DispatchingEvents );
+
+		int32 NumFired[ 3 ] = { 0 };
+		for ( FEvent& Event : DispatchingEvents )
+		{
+			// A callback earlier in the batch may have cancelled the tween
+			FBUITweenInstance* Instance = FindEventInstance( Event );
+			Event.bHasFired = Instance && Instance->DoNativeEvent( Event.Type );
+			NumFired[ static_cast<int32>( Event.Type ) ] += Event.bHasFired ? 1 : 0;
+		}
+		INC_DWORD_STAT_BY( STAT_BUITween_NumStarted, NumFired[ static_cast<int32>( EBUITweenEvent::Start ) ] );
+		INC_DWORD_STAT_BY( STAT_BUITween_NumLooped, NumFired[ static_cast<int32>( EBUITweenEvent::Loop ) ] );
+		INC_DWORD_STAT_BY( STAT_BUITween_NumCompleted, NumFired[ static_cast<int32>( EBUITweenEvent::Complete ) ] );
+
+		{
+			// Each Blueprint delegate is a trip into the script VM, so they all go out together after the
+			// native callbacks rather than interleaved with them
+			BUITWEEN_SCOPE( BlueprintCallbacks );
+			for ( const FEvent& Event : DispatchingEvents )
+			{
+				FBUITweenInstance* Instance = Event.bHasFired ? FindEventInstance( Event ) : nullptr;
+				if ( Instance )
+				{
+					Instance->DoBlueprintEvent( Event.Type );
+				}
+			}
+		}
+
+		for ( const FEvent& Event : DispatchingEvents )
+		{
+			const bool bIsSlotComplete = Event.Type == EBUITweenEvent::Complete && Event.StepIndex == INDEX_NONE;
+			const FBUITweenSlot* Slot = bIsSlotComplete ? GetSlot( Event.Handle ) : nullptr;
+			if ( Slot && Slot->State == EBUITweenSlotState::Completing )
+			{
+				FreeSlot( Event.Handle.Index );
+			}
+		}
+		DispatchingEvents.Reset();
+	}
+
+	bIsDispatching = false;
+
+	ActivatePending();
+}
+
+
+void FBUITweenStorage::QueueEvent( int32 SlotIndex, EBUITweenEvent Type )
+{
+	QueueEvent( Slots[ SlotIndex ].Instance.Handle, Type );
+}
+
+
+void FBUITweenStorage::QueueEvent( const FBUITweenHandle& Handle, EBUITweenEvent Type, int32 StepIndex )
+{
+	Events.Add( { Handle, StepIndex, Type, false } );
+}
+
+
+FBUITweenInstance* FBUITweenStorage::FindEventInstance( const FEvent& Event )
+{
+	FBUITweenSlot* Slot = GetSlot( Event.Handle );
+	if ( !Slot || Event.StepIndex == INDEX_NONE )
+	{
+		return Slot ? &Slot->Instance : nullptr;
+	}
+	const TUniquePtr<FBUITweenSequence>& Sequence = Slot->Sequence;
+	return Sequence.IsValid() && Sequence->Steps.IsValidIndex( Event.StepIndex ) ? &Sequence->Steps[ Event.StepIndex ].Instance : nullptr;
+}
+
+
+void FBUITweenStorage::CompleteAll()
+{
+	if ( !ensureMsgf( !bIsUpdating, TEXT( "CompleteAll can't be called from a tween callback" ) ) )
+	{
+		return;
+	}
+
+	// Pull the pending tweens in first so a single update finishes everything that exists right now.
+	// Tweens created by the complete callbacks are left pending for the next update.
+	ActivatePending();
+	for ( FBUITweenHeader& Header : Headers )
+	{
+		if ( Header.bShouldUpdate && !Header.bIsComplete )
+		{
+			// Lands where the last cycle would have, an infinite loop ends the cycle it's in
+			if ( Header.bIsPingPong && Header.LoopsLeft > 0 )
+			{
+				Header.bIsReversed ^= ( Header.LoopsLeft % 2 ) == 1;
+			}
+			Header.LoopsLeft = 0;
+			Header.Delay = 0;
+			Header.Alpha = Header.Duration;
+			Header.bIsPaused = false;
+
+			// Springs have no end time, they are moved onto their targets and settle in the update
+			if ( Header.bIsSpring )
+			{
+				Header.bIsSleeping = false;
+				Header.bKeepAliveWhenSettled = false;
+				auto SnapToTarget = [ &Header ]( EBUITweenChannel Channel, auto& Storage )
+				{
+					if ( Header.HasChannel( Channel ) )
+					{
+						const int32 First = Header.ChannelIndices[ static_cast<int32>( Channel ) ];
+						for ( int32 Index = First; Index < First + Header.NumEntries( Channel ); ++Index )
+						{
+							Storage.Entries[ Index ].StartValue = Storage.Entries[ Index ].TargetValue;
+							FMemory::Memzero( Storage.Velocities[ Index ] );
+						}
+					}
+				};
+				SnapToTarget( EBUITweenChannel::Translation, TranslationChannel );
+				SnapToTarget( EBUITweenChannel::Scale, ScaleChannel );
+				SnapToTarget( EBUITweenChannel::Rotation, RotationChannel );
+				SnapToTarget( EBUITweenChannel::Opacity, OpacityChannel );
+				SnapToTarget( EBUITweenChannel::Color, ColorChannel );
+				SnapToTarget( EBUITweenChannel::CanvasPosition, CanvasPositionChannel );
+				SnapToTarget( EBUITweenChannel::Padding, PaddingChannel );
+				SnapToTarget( EBUITweenChannel::MaxDesiredHeight, MaxDesiredHeightChannel );
+				SnapToTarget( EBUITweenChannel::MaterialParameter, MaterialParameterChannel );
+				SnapToTarget( EBUITweenChannel::Property, PropertyChannel );
+			}
+		}
+	}
+	Update( 0 );
+	DispatchEvents();
+}
+
+
+void FBUITweenStorage::ActivatePending()
+{
+	for ( const FBUITweenHandle& Handle : PendingHandles )
+	{
+		const FBUITweenSlot* Slot = GetSlot( Handle );
+		if ( Slot && Slot->State == EBUITweenSlotState::Pending )
+		{
+			Activate( Handle.Index );
+		}
+	}
+	PendingHandles.Reset();
+}
+
+
+void FBUITweenStorage::Evaluate( float DeltaTime )
+{
+	const bool bForceSingleThread = CVarBUITweenParallelEvaluate.GetValueOnGameThread() == 0;
+
+	const int32 NumHeaderChunks = FMath::DivideAndRoundUp( Headers.Num(), EvaluateChunkSize );
+	ParallelFor( NumHeaderChunks, [ this, DeltaTime ]( int32 ChunkIndex )
+	{
+		const int32 Start = ChunkIndex * EvaluateChunkSize;
+		const int32 End = FMath::Min( Start + EvaluateChunkSize, Headers.Num() );
+		for ( int32 i = Start; i < End; ++i )
+		{
+			EvaluateHeader( Headers[ i ], DeltaTime );
+		}
+	}, bForceSingleThread || NumHeaderChunks < 2 );
+
+	EvaluateEasing( bForceSingleThread );
+
+	// Every channel is split into chunks and all of them go out as one batch, so a tween set that only
+	// uses opacity doesn't wait on empty channels
+	ChannelWork.Reset();
+	for ( int32 Channel = 0; Channel < static_cast<int32>( EBUITweenChannel::Num ); ++Channel )
+	{
+		const int32 NumEntries = GetChannel( static_cast<EBUITweenChannel>( Channel ) ).Num();
+		for ( int32 Start = 0; Start < NumEntries; Start += EvaluateChunkSize )
+		{
+			ChannelWork.Add( { static_cast<EBUITweenChannel>( Channel ), Start, FMath::Min( Start + EvaluateChunkSize, NumEntries ) } );
+		}
+	}
+
+	ParallelFor( ChannelWork.Num(), [ this ]( int32 WorkIndex )
+	{
+		const FChannelWork& Work = ChannelWork[ WorkIndex ];
+		switch ( Work.Channel )
+		{
+			case EBUITweenChannel::Translation: EvaluateChannel( TranslationChannel, TranslationEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::Scale: EvaluateChannel( ScaleChannel, ScaleEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::Rotation: EvaluateChannel( RotationChannel, RotationEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::Opacity: EvaluateChannel( OpacityChannel, OpacityEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::Color: EvaluateChannel( ColorChannel, ColorEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::Visibility: EvaluateVisibility( Work.Start, Work.End ); break;
+			case EBUITweenChannel::CanvasPosition: EvaluateChannel( CanvasPositionChannel, LayoutEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::Padding: EvaluateChannel( PaddingChannel, LayoutEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::MaxDesiredHeight: EvaluateChannel( MaxDesiredHeightChannel, LayoutEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::MaterialParameter: EvaluateChannel( MaterialParameterChannel, MaterialEpsilon, Work.Start, Work.End ); break;
+			case EBUITweenChannel::Property: EvaluateChannel( PropertyChannel, PropertyEpsilon, Work.Start, Work.End ); break;
+			default: break;
+		}
+	}, bForceSingleThread || ChannelWork.Num() < 2 );
+
+	SettleSprings();
+}
+
+
+void FBUITweenStorage::SettleSprings()
+{
+	// A header's channels may have been evaluated on different workers, so this is a serial pass after them
+	for ( FBUITweenHeader& Header : Headers )
+	{
+		if ( !Header.bIsSpring || !Header.bIsRunning )
+		{
+			continue;
+		}
+
+		bool bIsSettled = true;
+		bIsSettled &= SettleSpringChannel( TranslationChannel, Header, EBUITweenChannel::Translation, TranslationEpsilon );
+		bIsSettled &= SettleSpringChannel( ScaleChannel, Header, EBUITweenChannel::Scale, ScaleEpsilon );
+		bIsSettled &= SettleSpringChannel( RotationChannel, Header, EBUITweenChannel::Rotation, RotationEpsilon );
+		bIsSettled &= SettleSpringChannel( OpacityChannel, Header, EBUITweenChannel::Opacity, OpacityEpsilon );
+		bIsSettled &= SettleSpringChannel( ColorChannel, Header, EBUITweenChannel::Color, ColorEpsilon );
+		bIsSettled &= SettleSpringChannel( CanvasPositionChannel, Header, EBUITweenChannel::CanvasPosition, LayoutEpsilon );
+		bIsSettled &= SettleSpringChannel( PaddingChannel, Header, EBUITweenChannel::Padding, LayoutEpsilon );
+		bIsSettled &= SettleSpringChannel( MaxDesiredHeightChannel, Header, EBUITweenChannel::MaxDesiredHeight, LayoutEpsilon );
+		bIsSettled &= SettleSpringChannel( MaterialParameterChannel, Header, EBUITweenChannel::MaterialParameter, MaterialEpsilon );
+		bIsSettled &= SettleSpringChannel( PropertyChannel, Header, EBUITweenChannel::Property, PropertyEpsilon );
+		if ( !bIsSettled )
+		{
+			continue;
+		}
+
+		// Land exactly, then visibility switches the way it does at the end of a duration tween
+		auto Snap = [ &Header ]( EBUITweenChannel Channel, auto& Storage )
+		{
+			if ( Header.HasChannel( Channel ) )
+			{
+				const int32 First = Header.ChannelIndices[ static_cast<int32>( Channel ) ];
+				for ( int32 Index = First; Index < First + Header.NumEntries( Channel ); ++Index )
+				{
+					auto& Entry = Storage.Entries[ Index ];
+					Entry.StartValue = Entry.TargetValue;
+					FMemory::Memzero( Storage.Velocities[ Index ] );
+					Entry.bIsDirty |= Entry.CurrentValue != Entry.TargetValue;
+					Entry.CurrentValue = Entry.TargetValue;
+				}
+			}
+		};
+		Snap( EBUITweenChannel::Translation, TranslationChannel );
+		Snap( EBUITweenChannel::Scale, ScaleChannel );
+		Snap( EBUITweenChannel::Rotation, RotationChannel );
+		Snap( EBUITweenChannel::Opacity, OpacityChannel );
+		Snap( EBUITweenChannel::Color, ColorChannel );
+		Snap( EBUITweenChannel::Visibility, VisibilityChannel );
+		Snap( EBUITweenChannel::CanvasPosition, CanvasPositionChannel );
+		Snap( EBUITweenChannel::Padding, PaddingChannel );
+		Snap( EBUITweenChannel::MaxDesiredHeight, MaxDesiredHeightChannel );
+		Snap( EBUITweenChannel::MaterialParameter, MaterialParameterChannel );
+		Snap( EBUITweenChannel::Property, PropertyChannel );
+
+		Header.EasedAlpha = 1;
+		if ( Header.bKeepAliveWhenSettled )
+		{
+			Header.bIsSleeping = true;
+		}
+		else
+		{
+			Header.bIsComplete = true;
+		}
+	}
+}
+
+
+template<typename T>
+bool FBUITweenStorage::SettleSpringChannel( TBUITweenChannel<T>& Channel, const FBUITweenHeader& Header, EBUITweenChannel ChannelType, float Epsilon )
+{
+	if ( !Header.HasChannel( ChannelType ) )
+	{
+		return true;
+	}
+
+	// Close enough to the target and moving less than an epsilon per second
+	const int32 First = Header.ChannelIndices[ static_cast<int32>( ChannelType ) ];
+	for ( int32 Index = First; Index < First + Header.NumEntries( ChannelType ); ++Index )
+	{
+		const typename TBUITweenChannel<T>::FEntry& Entry = Channel.Entries[ Index ];
+		if ( !IsWithinEpsilon( Entry.StartValue, Entry.TargetValue, Epsilon )
+			|| !IsWithinEpsilon( Entry.StartValue + Channel.Velocities[ Index ], Entry.StartValue, Epsilon ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+void FBUITweenStorage::EvaluateHeader( FBUITweenHeader& Header, float DeltaTime )
+{
+	Header.bIsRunning = false;
+	Header.bStartedThisFrame = false;
+	Header.bLoopedThisFrame = false;
+
+	if ( !Header.bShouldUpdate || Header.bIsPaused || Header.bIsComplete || Header.bIsSleeping )
+	{
+		return;
+	}
+
+	if ( Header.Delay != 0 )
+	{
+		// Whatever is left of the frame once the delay runs out goes to the tween, so tweens staggered by
+		// delay stay in phase at any frame rate. A negative delay is a head start.
+		Header.Delay -= DeltaTime;
+		if ( Header.Delay > 0 )
+		{
+			return;
+		}
+		DeltaTime = -Header.Delay;
+		Header.Delay = 0;
+		// A repeat delay ran out, the next cycle starts from the beginning
+		if ( Header.bHasStarted )
+		{
+			Header.Alpha = 0;
+		}
+	}
+
+	if ( !Header.bHasStarted )
+	{
+		Header.bHasStarted = true;
+		Header.bStartedThisFrame = true;
+	}
+
+	if ( Header.bIsSpring )
+	{
+		// Alpha is only the time the spring has run, SettleSprings() decides when it's done
+		Header.Alpha += DeltaTime;
+		FBUITweenSpringState& SpringState = Springs[ Header.SpringIndex ];
+		SpringState.Step = SpringState.Spring.Step( DeltaTime );
+		Header.EasedAlpha = 0;
+		Header.bIsRunning = true;
+		return;
+	}
+
+	Header.Alpha += DeltaTime;
+	if ( Header.Alpha >= Header.Duration && Header.LoopsLeft != 0 )
+	{
+		// Wraps in place, taking off every whole cycle a long frame ran through at once. Stepping one cycle
+		// at a time never ends for a short infinite loop once the time outgrows the float precision.
+		const float Period = Header.Duration + Header.RepeatDelay;
+		const float Overflow = Header.Alpha - Header.Duration;
+		int32 NumCycles = 1 + ( Period > 0 ? FMath::FloorToInt( FMath::Min( Overflow / Period, 1.0e9f ) ) : 0 );
+		float Remainder = Period > 0 ? FMath::Fmod( Overflow, Period ) : 0.0f;
+		if ( Header.LoopsLeft > 0 && NumCycles > Header.LoopsLeft )
+		{
+			// Whatever is left after the last cycle runs it to completion below
+			NumCycles = Header.LoopsLeft;
+			Remainder = Overflow - ( NumCycles - 1 ) * Period;
+		}
+		Header.LoopsLeft -= Header.LoopsLeft > 0 ? NumCycles : 0;
+		Header.bLoopedThisFrame = true;
+		Header.bIsReversed ^= Header.bIsPingPong && ( NumCycles & 1 );
+
+		if ( Remainder < Header.RepeatDelay )
+		{
+			// Holds where this cycle ended for the rest of the repeat delay, which is the start of the next
+			// one for a ping-pong. Running out of the delay then restarts the time.
+			Header.Delay = Header.RepeatDelay - Remainder;
+			Header.Alpha = Header.bIsPingPong ? 0 : Header.Duration;
+		}
+		else
+		{
+			Header.Alpha = Remainder - Header.RepeatDelay;
+		}
+	}
+	if ( Header.Alpha >= Header.Duration && Header.LoopsLeft == 0 && Header.Delay == 0 )
+	{
+		Header.Overflow = Header.Alpha - Header.Duration;
+		Header.Alpha = Header.Duration;
+		Header.bIsComplete = true;
+	}
+
+	if ( Header.bCarriesVelocity )
+	{
+		// Duration times the Hermite basis s * ( 1 - s )^2, zero at both ends
+		const float S = Header.Duration > 0 ? Header.Alpha / Header.Duration : 1.0f;
+		Header.VelocityWeight = Header.Duration * S * ( 1 - S ) * ( 1 - S );
+	}
+
+	Header.bIsRunning = true;
+}
+
+
+void FBUITweenStorage::EvaluateEasing( bool bForceSingleThread )
+{
+	// Counting sort of the running headers by easing type, so every type goes through one batched kernel
+	int32 TypeOffsets[ FBUIEasing::NumTypes + 1 ] = { 0 };
+	for ( const FBUITweenHeader& Header : Headers )
+	{
+		if ( Header.bIsRunning && !Header.bIsSpring )
+		{
+			++TypeOffsets[ static_cast<int32>( Header.EasingType ) + 1 ];
+		}
+	}
+	for ( int32 Type = 0; Type < FBUIEasing::NumTypes; ++Type )
+	{
+		TypeOffsets[ Type + 1 ] += TypeOffsets[ Type ];
+	}
+
+	const int32 NumRunning = TypeOffsets[ FBUIEasing::NumTypes ];
+	EaseHeaderIndices.SetNumUninitialized( NumRunning, false );
+	EaseTimes.SetNumUninitialized( NumRunning, false );
+	EaseDurations.SetNumUninitialized( NumRunning, false );
+	EaseParams.SetNumUninitialized( NumRunning, false );
+	EaseValues.SetNumUninitialized( NumRunning, false );
+
+	const FBUIEasingLUT& EasingLUT = FBUIEasingLUT::Get();
+	const bool bUseLUT = EasingLUT.IsEnabled();
+	const uint32 LUTGeneration = EasingLUT.GetGeneration();
+	EaseTables.SetNumUninitialized( bUseLUT ? NumRunning : 0, false );
+
+	EaseWork.Reset();
+	for ( int32 Type = 0; Type < FBUIEasing::NumTypes; ++Type )
+	{
+		for ( int32 Start = TypeOffsets[ Type ]; Start < TypeOffsets[ Type + 1 ]; Start += EvaluateChunkSize )
+		{
+			EaseWork.Add( { static_cast<EBUIEasingType>( Type ), Start, FMath::Min( Start + EvaluateChunkSize, TypeOffsets[ Type + 1 ] ) } );
+		}
+	}
+
+	for ( int32 i = 0; i < Headers.Num(); ++i )
+	{
+		FBUITweenHeader& Header = Headers[ i ];
+		if ( Header.bIsRunning && !Header.bIsSpring )
+		{
+			const int32 Slot = TypeOffsets[ static_cast<int32>( Header.EasingType ) ]++;
+			EaseHeaderIndices[ Slot ] = i;
+			// A zero length tween is just its end value
+			EaseTimes[ Slot ] = Header.Duration > 0 ? Header.GetCycleTime() : 1.0f;
+			EaseDurations[ Slot ] = Header.Duration > 0 ? Header.Duration : 1.0f;
+			EaseParams[ Slot ] = Header.bHasEasingParam ? Header.EasingParam : FBUIEasing::DefaultParam;
+			if ( bUseLUT )
+			{
+				// Only looked up again when the tables were rebuilt since the tween began, and then never built
+				if ( Header.EasingTableGeneration != LUTGeneration )
+				{
+					Header.pEasingTable = EasingLUT.Find( Header.EasingType, Header.Duration, EaseParams[ Slot ] );
+					Header.EasingTableGeneration = LUTGeneration;
+				}
+				EaseTables[ Slot ] = Header.pEasingTable;
+			}
+		}
+	}
+
+	ParallelFor( EaseWork.Num(), [ this, bUseLUT ]( int32 WorkIndex )
+	{
+		const FEaseWork& Work = EaseWork[ WorkIndex ];
+		if ( bUseLUT && FBUIEasingLUT::UsesTable( Work.Type ) )
+		{
+			for ( int32 i = Work.Start; i < Work.End; ++i )
+			{
+				EaseValues[ i ] = EaseTables[ i ]
+					? FBUIEasingLUT::Ease( *EaseTables[ i ], Work.Type, EaseTimes[ i ], EaseDurations[ i ], EaseParams[ i ] )
+					: FBUIEasing::Ease( Work.Type, EaseTimes[ i ], EaseDurations[ i ], EaseParams[ i ] );
+			}
+		}
+		else
+		{
+			const int32 Num = Work.End - Work.Start;
+			FBUIEasing::EaseBatch( Work.Type, &EaseTimes[ Work.Start ], &EaseDurations[ Work.Start ], &EaseParams[ Work.Start ], &EaseValues[ Work.Start ], Num );
+		}
+
+		for ( int32 i = Work.Start; i < Work.End; ++i )
+		{
+			Headers[ EaseHeaderIndices[ i ] ].EasedAlpha = EaseValues[ i ];
+		}
+	}, bForceSingleThread || EaseWork.Num() < 2 );
+}
+
+
+template<typename T>
+void FBUITweenStorage::EvaluateChannel( TBUITweenChannel<T>& Channel, float Epsilon, int32 Start, int32 End ) const
+{
+	// CurrentValue is what was last applied, so changes smaller than the epsilon build up until they're worth a write
+	for ( int32 i = Start; i < End; ++i )
+	{
+		typename TBUITweenChannel<T>::FEntry& Entry = Channel.Entries[ i ];
+		const FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && Header.bIsSpring )
+		{
+			const FBUITweenSpring::FStep& Step = Springs[ Header.SpringIndex ].Step;
+			const T Displacement = Entry.StartValue - Entry.TargetValue;
+			const T Velocity = Channel.Velocities[ i ];
+			Entry.StartValue = Entry.TargetValue + Displacement * Step.YY + Velocity * Step.YV;
+			Channel.Velocities[ i ] = Displacement * Step.VY + Velocity * Step.VV;
+
+			Entry.bIsDirty = !IsWithinEpsilon( Entry.StartValue, Entry.CurrentValue, Epsilon );
+			if ( Entry.bIsDirty )
+			{
+				Entry.CurrentValue = Entry.StartValue;
+			}
+		}
+		else if ( Header.bIsRunning )
+		{
+			TBUITweenKeyCursor<T>* pCursor = Header.bHasKeys && Channel.KeyCursors[ i ].pKeys ? &Channel.KeyCursors[ i ] : nullptr;
+			T NewValue = pCursor ? pCursor->pKeys->Evaluate( Entry.StartValue, Header.EasedAlpha, pCursor->Next )
+				: FMath::Lerp( Entry.StartValue, Entry.TargetValue, Header.EasedAlpha );
+			if ( Header.bCarriesVelocity )
+			{
+				NewValue += ( Channel.Velocities[ i ] - ( Entry.TargetValue - Entry.StartValue ) * Header.EaseStartSlope ) * Header.VelocityWeight;
+			}
+			Entry.bIsDirty = Header.bIsComplete ? NewValue != Entry.CurrentValue : !IsWithinEpsilon( NewValue, Entry.CurrentValue, Epsilon );
+			if ( Entry.bIsDirty )
+			{
+				Entry.CurrentValue = NewValue;
+			}
+		}
+		else
+		{
+			Entry.bIsDirty = false;
+		}
+	}
+}
+
+
+void FBUITweenStorage::EvaluateVisibility( int32 Start, int32 End )
+{
+	// Only apply visibility changes at 0 or 1
+	for ( int32 i = Start; i < End; ++i )
+	{
+		TBUITweenChannel<ESlateVisibility>::FEntry& Entry = VisibilityChannel.Entries[ i ];
+		const FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning )
+		{
+			const ESlateVisibility NewValue = Header.EasedAlpha >= 1 ? Entry.TargetValue : Entry.StartValue;
+			Entry.bIsDirty = NewValue != Entry.CurrentValue;
+			Entry.CurrentValue = NewValue;
+		}
+		else
+		{
+			Entry.bIsDirty = false;
+		}
+	}
+}
+
+
+// Walks up through the panels and on across user widget boundaries
+static UWidget* GetHierarchyParent( UWidget* pWidget )
+{
+	if ( UWidget* pParent = pWidget->GetParent() )
+	{
+		return pParent;
+	}
+	UWidgetTree* pTree = Cast<UWidgetTree>( pWidget->GetOuter() );
+	return pTree ? Cast<UUserWidget>( pTree->GetOuter() ) : nullptr;
+}
+
+
+// Returns true if anything from the widget up hides it, otherwise OutScrollBox is the nearest ScrollBox that
+// could still scroll it out of view. The widget's own visibility and opacity are skipped when the tween
+// drives them, a fade in starts hidden.
+bool FBUITweenStorage::IsHiddenInHierarchy( UWidget* pWidget, bool bCheckVisibility, bool bCheckOpacity, UScrollBox*& OutScrollBox )
+{
+	OutScrollBox = nullptr;
+	if ( ( bCheckVisibility && !pWidget->IsVisible() ) || ( bCheckOpacity && pWidget->GetRenderOpacity() <= 0 ) )
+	{
+		return true;
+	}
+
+	UWidget* pParent = GetHierarchyParent( pWidget );
+	if ( !pParent )
+	{
+		return false;
+	}
+	const FHiddenCheck Above = CheckAncestors( pParent );
+	UScrollBox* pParentScrollBox = Cast<UScrollBox>( pParent );
+	OutScrollBox = pParentScrollBox ? pParentScrollBox : Above.pScrollBox;
+	return Above.bIsHidden;
+}
+
+
+FBUITweenStorage::FHiddenCheck FBUITweenStorage::CheckAncestors( UWidget* pWidget )
+{
+	// Up to the first ancestor another tween already checked this frame, then filled in back down
+	AncestorChain.Reset();
+	FHiddenCheck Above = { false, nullptr };
+	UWidget* pAbove = nullptr;
+	for ( UWidget* pIt = pWidget; pIt; pIt = GetHierarchyParent( pIt ) )
+	{
+		if ( const FHiddenCheck* Found = HiddenChecks.Find( pIt ) )
+		{
+			Above = *Found;
+			pAbove = pIt;
+			break;
+		}
+		AncestorChain.Add( pIt );
+	}
+
+	for ( int32 i = AncestorChain.Num() - 1; i >= 0; --i )
+	{
+		UWidget* pIt = AncestorChain[ i ];
+		UScrollBox* pAboveScrollBox = Cast<UScrollBox>( pAbove );
+		Above.bIsHidden = Above.bIsHidden || !pIt->IsVisible() || pIt->GetRenderOpacity() <= 0;
+		Above.pScrollBox = pAboveScrollBox ? pAboveScrollBox : Above.pScrollBox;
+		HiddenChecks.Add( pIt, Above );
+		pAbove = pIt;
+	}
+	return Above;
+}
+
+
+void FBUITweenStorage::Cull()
+{
+	ApplyStats.NumCulled = 0;
+
+	for ( int32 i = 0; i < Headers.Num(); ++i )
+	{
+		FBUITweenHeader& Header = Headers[ i ];
+		if ( !Header.bCullWhenHidden || !Header.bIsRunning || Header.bIsCancelled )
+		{
+			continue;
+		}
+		// The last frame always applies, so the widget is right whenever it shows again. A spring that just
+		// went to sleep won't be evaluated again until it's retargeted, so it counts as a last frame too.
+		if ( Header.bIsComplete || Header.bIsSleeping )
+		{
+			SetCulled( Header, false );
+			continue;
+		}
+
+		UWidget* pWidget = Header.pWidget.Get();
+		if ( !pWidget )
+		{
+			continue;
+		}
+
+		UScrollBox* pScrollBox;
+		const bool bIsHidden = IsHiddenInHierarchy( pWidget,
+			!Header.HasChannel( EBUITweenChannel::Visibility ), !Header.HasChannel( EBUITweenChannel::Opacity ), pScrollBox );
+
+		TSharedPtr<SWidget> SlateWidget = pWidget->GetCachedWidget();
+		if ( bIsHidden || !pScrollBox || !SlateWidget.IsValid() || !pScrollBox->GetCachedWidget().IsValid() )
+		{
+			SetCulled( Header, bIsHidden );
+			continue;
+		}
+		ScrollChecks.Add( { i, pScrollBox, SlateWidget.ToSharedRef() } );
+	}
+	HiddenChecks.Reset();
+
+	if ( ScrollChecks.Num() == 0 )
+	{
+		return;
+	}
+
+	// Grouped by ScrollBox, so each one arranges its children once for every tween inside it
+	ScrollChecks.Sort( []( const FScrollCheck& A, const FScrollCheck& B )
+	{
+		return A.pScrollBox < B.pScrollBox;
+	} );
+
+	for ( int32 Start = 0; Start < ScrollChecks.Num(); )
+	{
+		UScrollBox* pScrollBox = ScrollChecks[ Start ].pScrollBox;
+		int32 End = Start;
+		WidgetsToFind.Reset();
+		while ( End < ScrollChecks.Num() && ScrollChecks[ End ].pScrollBox == pScrollBox )
+		{
+			WidgetsToFind.Add( ScrollChecks[ End ].Widget );
+			++End;
+		}
+
+		// Arranged from the ScrollBox's current geometry, a row that wasn't painted has stale geometry of its own
+		const FGeometry& ViewGeometry = pScrollBox->GetCachedGeometry();
+		FoundGeometries.Reset();
+		pScrollBox->GetCachedWidget()->FindChildGeometries( ViewGeometry, WidgetsToFind, FoundGeometries );
+
+		const FSlateRect ViewRect = ViewGeometry.GetLayoutBoundingRect();
+		for ( int32 i = Start; i < End; ++i )
+		{
+			// Not arranged at all means something in between doesn't show it
+			const FArrangedWidget* Found = FoundGeometries.Find( ScrollChecks[ i ].Widget );
+			const bool bIsInView = Found && FSlateRect::DoRectanglesIntersect( Found->Geometry.GetLayoutBoundingRect(), ViewRect );
+			SetCulled( Headers[ ScrollChecks[ i ].HeaderIndex ], !bIsInView );
+		}
+		Start = End;
+	}
+
+	ScrollChecks.Reset();
+	WidgetsToFind.Reset();
+	FoundGeometries.Reset();
+}
+
+
+void FBUITweenStorage::SetCulled( FBUITweenHeader& Header, bool bInIsCulled )
+{
+	if ( Header.bIsCulled && !bInIsCulled )
+	{
+		// Nothing was written while culled, so every channel snaps to its current value
+		auto MarkDirty = [ &Header ]( EBUITweenChannel Channel, auto& Storage )
+		{
+			if ( Header.HasChannel( Channel ) )
+			{
+				const int32 First = Header.ChannelIndices[ static_cast<int32>( Channel ) ];
+				for ( int32 Index = First; Index < First + Header.NumEntries( Channel ); ++Index )
+				{
+					Storage.Entries[ Index ].bIsDirty = true;
+				}
+			}
+		};
+
+		MarkDirty( EBUITweenChannel::Translation, TranslationChannel );
+		MarkDirty( EBUITweenChannel::Scale, ScaleChannel );
+		MarkDirty( EBUITweenChannel::Rotation, RotationChannel );
+		MarkDirty( EBUITweenChannel::Opacity, OpacityChannel );
+		MarkDirty( EBUITweenChannel::Color, ColorChannel );
+		MarkDirty( EBUITweenChannel::Visibility, VisibilityChannel );
+		MarkDirty( EBUITweenChannel::CanvasPosition, CanvasPositionChannel );
+		MarkDirty( EBUITweenChannel::Padding, PaddingChannel );
+		MarkDirty( EBUITweenChannel::MaxDesiredHeight, MaxDesiredHeightChannel );
+		MarkDirty( EBUITweenChannel::MaterialParameter, MaterialParameterChannel );
+		MarkDirty( EBUITweenChannel::Property, PropertyChannel );
+	}
+
+	Header.bIsCulled = bInIsCulled;
+	if ( bInIsCulled )
+	{
+		++ApplyStats.NumCulled;
+	}
+}
+
+
+void FBUITweenStorage::Apply()
+{
+	const int64 NumCulled = ApplyStats.NumCulled;
+	ApplyStats = FBUITweenApplyStats();
+	ApplyStats.NumCulled = NumCulled;
+	WidgetWrites.Reset();
+	WidgetWriteIndices.Reset();
+
+	// Resolving the widget is the first UObject access of the frame, it also gathers the transform
+	// channels back together since they share one render transform per widget
+	for ( int32 i = 0; i < Headers.Num(); ++i )
+	{
+		FBUITweenHeader& Header = Headers[ i ];
+		Header.pResolvedWidget = nullptr;
+
+		if ( !Header.bShouldUpdate || Header.bIsPaused || Header.bIsCancelled )
+		{
+			continue;
+		}
+		if ( Header.bIsGroup )
+		{
+			if ( Header.bIsRunning )
+			{
+				if ( Header.bStartedThisFrame )
+				{
+					QueueEvent( Header.SlotIndex, EBUITweenEvent::Start );
+				}
+				// A group has no channels of its own, its steps and elements add their transform, color and
+				// opacity to the widget writes so a widget several of them touch is written once
+				FBUITweenSlot& Slot = Slots[ Header.SlotIndex ];
+				if ( Slot.Sequence.IsValid() )
+				{
+					Slot.Sequence->Advance( Header.Alpha, *this );
+				}
+				else
+				{
+					Slot.Stagger->Advance( Slot.Instance, Header.Alpha, *this );
+				}
+			}
+			continue;
+		}
+		if ( Header.bIsSlate )
+		{
+			// The slot is only touched by Slate tweens, everything else goes through the header
+			const TSharedPtr<SWidget> SlateWidget = Slots[ Header.SlotIndex ].Instance.SlateWidget.Pin();
+			if ( !SlateWidget.IsValid() )
+			{
+				Header.bIsComplete = true;
+				Header.bIsRunning = false;
+			}
+			else if ( Header.bIsRunning )
+			{
+				if ( Header.bStartedThisFrame )
+				{
+					QueueEvent( Header.SlotIndex, EBUITweenEvent::Start );
+				}
+				if ( Header.bLoopedThisFrame )
+				{
+					QueueEvent( Header.SlotIndex, EBUITweenEvent::Loop );
+				}
+				ApplySlate( Header, *SlateWidget );
+			}
+			continue;
+		}
+		Header.pResolvedWidget = Header.pWidget.Get();
+		if ( !Header.pResolvedWidget )
+		{
+			Header.bIsComplete = true;
+			Header.bIsRunning = false;
+			continue;
+		}
+		if ( !Header.bIsRunning )
+		{
+			continue;
+		}
+
+		if ( Header.bStartedThisFrame )
+		{
+			QueueEvent( Header.SlotIndex, EBUITweenEvent::Start );
+		}
+		if ( Header.bLoopedThisFrame )
+		{
+			QueueEvent( Header.SlotIndex, EBUITweenEvent::Loop );
+		}
+		if ( Header.bIsCulled )
+		{
+			continue;
+		}
+
+		const bool bHasTranslation = Header.HasChannel( EBUITweenChannel::Translation );
+		const bool bHasScale = Header.HasChannel( EBUITweenChannel::Scale );
+		const bool bHasRotation = Header.HasChannel( EBUITweenChannel::Rotation );
+		if ( !bHasTranslation && !bHasScale && !bHasRotation )
+		{
+			continue;
+		}
+
+		++ApplyStats.NumRequested;
+		const bool bTranslationChanged = bHasTranslation && TranslationChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Translation ) ] ].bIsDirty;
+		const bool bScaleChanged = bHasScale && ScaleChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Scale ) ] ].bIsDirty;
+		const bool bRotationChanged = bHasRotation && RotationChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Rotation ) ] ].bIsDirty;
+		if ( !bTranslationChanged && !bScaleChanged && !bRotationChanged )
+		{
+			continue;
+		}
+
+		FBUITweenWidgetWrite* pWrite = Header.bSharesWidget ? &FindOrAddWidgetWrite( Header.pResolvedWidget ) : nullptr;
+		FWidgetTransform CurrentTransform = pWrite && pWrite->bHasTransform ? pWrite->Transform : Header.pResolvedWidget->GetRenderTransform();
+		if ( bTranslationChanged )
+		{
+			CurrentTransform.Translation = TranslationChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Translation ) ] ].CurrentValue;
+		}
+		if ( bScaleChanged )
+		{
+			CurrentTransform.Scale = ScaleChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Scale ) ] ].CurrentValue;
+		}
+		if ( bRotationChanged )
+		{
+			CurrentTransform.Angle = RotationChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Rotation ) ] ].CurrentValue;
+		}
+
+		if ( pWrite )
+		{
+			pWrite->Transform = CurrentTransform;
+			pWrite->bHasTransform = true;
+		}
+		else
+		{
+			Header.pResolvedWidget->SetRenderTransform( CurrentTransform );
+			++ApplyStats.NumWrites;
+		}
+	}
+
+	for ( const auto& Entry : ColorChannel.Entries )
+	{
+		FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && !Header.bIsCulled )
+		{
+			++ApplyStats.NumRequested;
+			if ( !Entry.bIsDirty )
+			{
+				continue;
+			}
+			if ( Header.bSharesWidget )
+			{
+				FBUITweenWidgetWrite& Write = FindOrAddWidgetWrite( Header.pResolvedWidget );
+				Write.Color = Entry.CurrentValue;
+				Write.pColorTargets = &GetTargets( Header );
+			}
+			else
+			{
+				GetTargets( Header ).SetColor( Header.pResolvedWidget, Entry.CurrentValue );
+				++ApplyStats.NumWrites;
+			}
+		}
+	}
+	for ( const auto& Entry : OpacityChannel.Entries )
+	{
+		// Slate tweens already wrote theirs
+		const FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && !Header.bIsCulled && !Header.bIsSlate )
+		{
+			++ApplyStats.NumRequested;
+			if ( !Entry.bIsDirty )
+			{
+				continue;
+			}
+			if ( Header.bSharesWidget )
+			{
+				FBUITweenWidgetWrite& Write = FindOrAddWidgetWrite( Header.pResolvedWidget );
+				Write.Opacity = Entry.CurrentValue;
+				Write.bHasOpacity = true;
+			}
+			else
+			{
+				Header.pResolvedWidget->SetRenderOpacity( Entry.CurrentValue );
+				++ApplyStats.NumWrites;
+			}
+		}
+	}
+
+	// Widgets with more than one running tween or group step get a single write per property, last one wins as before
+	for ( const FBUITweenWidgetWrite& Write : WidgetWrites )
+	{
+		if ( Write.bHasTransform )
+		{
+			Write.pWidget->SetRenderTransform( Write.Transform );
+			++ApplyStats.NumWrites;
+		}
+		if ( Write.pColorTargets )
+		{
+			Write.pColorTargets->SetColor( Write.pWidget, Write.Color );
+			++ApplyStats.NumWrites;
+		}
+		if ( Write.bHasOpacity )
+		{
+			Write.pWidget->SetRenderOpacity( Write.Opacity );
+			++ApplyStats.NumWrites;
+		}
+	}
+
+	// Layout changes are rare enough that they're only gated on being dirty
+	for ( const auto& Entry : VisibilityChannel.Entries )
+	{
+		const FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && !Header.bIsCulled )
+		{
+			++ApplyStats.NumRequested;
+			if ( Entry.bIsDirty )
+			{
+				Header.pResolvedWidget->SetVisibility( Entry.CurrentValue );
+				++ApplyStats.NumWrites;
+			}
+		}
+	}
+	for ( const auto& Entry : CanvasPositionChannel.Entries )
+	{
+		FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && !Header.bIsCulled )
+		{
+			++ApplyStats.NumRequested;
+			if ( Entry.bIsDirty )
+			{
+				GetTargets( Header ).SetCanvasPosition( Header.pResolvedWidget, Entry.CurrentValue );
+				++ApplyStats.NumWrites;
+			}
+		}
+	}
+	for ( const auto& Entry : PaddingChannel.Entries )
+	{
+		FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && !Header.bIsCulled )
+		{
+			++ApplyStats.NumRequested;
+			if ( Entry.bIsDirty )
+			{
+				const FVector4& Padding = Entry.CurrentValue;
+				GetTargets( Header ).SetPadding( Header.pResolvedWidget, FMargin( Padding.X, Padding.Y, Padding.Z, Padding.W ) );
+				++ApplyStats.NumWrites;
+			}
+		}
+	}
+	for ( const auto& Entry : MaxDesiredHeightChannel.Entries )
+	{
+		const FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && !Header.bIsCulled )
+		{
+			++ApplyStats.NumRequested;
+			if ( Entry.bIsDirty )
+			{
+				GetTargets( Header ).SetMaxDesiredHeight( Header.pResolvedWidget, Entry.CurrentValue );
+				++ApplyStats.NumWrites;
+			}
+		}
+	}
+
+	// Written by the parameter indices resolved at Begin(), so there's no name lookup per write
+	for ( int32 i = 0; i < MaterialParameterChannel.Entries.Num(); ++i )
+	{
+		const auto& Entry = MaterialParameterChannel.Entries[ i ];
+		const FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && !Header.bIsCulled )
+		{
+			++ApplyStats.NumRequested;
+			FBUITweenMaterialBinding& Binding = MaterialParameterChannel.Bindings[ i ];
+			UMaterialInstanceDynamic* pMaterial = Entry.bIsDirty ? Binding.pMaterial.Get() : nullptr;
+			if ( pMaterial )
+			{
+				FBUITweenTargets::SetMaterialParameter( pMaterial, Binding.Name, Binding.bIsVector, Binding.ParameterIndex, Entry.CurrentValue );
+				++ApplyStats.NumWrites;
+			}
+		}
+	}
+
+	// Bindings come from the per class table, so a write is a store or a setter call with no lookup
+	for ( int32 i = 0; i < PropertyChannel.Entries.Num(); ++i )
+	{
+		const auto& Entry = PropertyChannel.Entries[ i ];
+		const FBUITweenHeader& Header = Headers[ Entry.Owner ];
+		if ( Header.bIsRunning && !Header.bIsCulled )
+		{
+			++ApplyStats.NumRequested;
+			if ( Entry.bIsDirty )
+			{
+				PropertyChannel.Bindings[ i ].Write( Header.pResolvedWidget, Entry.CurrentValue );
+				++ApplyStats.NumWrites;
+			}
+		}
+	}
+
+	TotalApplyStats.NumRequested += ApplyStats.NumRequested;
+	TotalApplyStats.NumWrites += ApplyStats.NumWrites;
+}
+
+
+void FBUITweenStorage::ApplySlate( FBUITweenHeader& Header, SWidget& InWidget )
+{
+	const bool bHasTranslation = Header.HasChannel( EBUITweenChannel::Translation );
+	const bool bHasScale = Header.HasChannel( EBUITweenChannel::Scale );
+	const bool bHasRotation = Header.HasChannel( EBUITweenChannel::Rotation );
+	if ( bHasTranslation || bHasScale || bHasRotation )
+	{
+		++ApplyStats.NumRequested;
+		const auto* pTranslation = bHasTranslation ? &TranslationChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Translation ) ] ] : nullptr;
+		const auto* pScale = bHasScale ? &ScaleChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Scale ) ] ] : nullptr;
+		const auto* pRotation = bHasRotation ? &RotationChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Rotation ) ] ] : nullptr;
+		if ( ( pTranslation && pTranslation->bIsDirty ) || ( pScale && pScale->bIsDirty ) || ( pRotation && pRotation->bIsDirty ) )
+		{
+			// Every component comes from the channels when the tween drives it, so only the others are read back
+			FWidgetTransform Transform = bHasTranslation && bHasScale && bHasRotation ? FWidgetTransform() : FBUITweenTargets::GetSlateRenderTransform( InWidget );
+			if ( pTranslation )
+			{
+				Transform.Translation = pTranslation->CurrentValue;
+			}
+			if ( pScale )
+			{
+				Transform.Scale = pScale->CurrentValue;
+			}
+			if ( pRotation )
+			{
+				Transform.Angle = pRotation->CurrentValue;
+			}
+			FBUITweenTargets::SetSlateRenderTransform( InWidget, Transform );
+			++ApplyStats.NumWrites;
+		}
+	}
+
+	if ( Header.HasChannel( EBUITweenChannel::Opacity ) )
+	{
+		++ApplyStats.NumRequested;
+		const auto& Entry = OpacityChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Opacity ) ] ];
+		if ( Entry.bIsDirty )
+		{
+			InWidget.SetRenderOpacity( Entry.CurrentValue );
+			++ApplyStats.NumWrites;
+		}
+	}
+}
+
+
+FBUITweenWidgetWrite& FBUITweenStorage::FindOrAddWidgetWrite( UWidget* pWidget )
+{
+	if ( const int32* pExisting = WidgetWriteIndices.Find( pWidget ) )
+	{
+		return WidgetWrites[ *pExisting ];
+	}
+	WidgetWriteIndices.Add( pWidget, WidgetWrites.Num() );
+	FBUITweenWidgetWrite& Write = WidgetWrites.AddDefaulted_GetRef();
+	Write.pWidget = pWidget;
+	return Write;
+}
+
+
+void FBUITweenStorage::RefreshSharesWidget( const FObjectKey& WidgetKey )
+{
+	const TArray< int32, TInlineAllocator<2> >* FoundSlots = WidgetSlots.Find( WidgetKey );
+	if ( !FoundSlots )
+	{
+		return;
+	}
+
+	// A staggered group counts too, its elements go through the widget writes
+	int32 NumActive = 0;
+	for ( int32 SlotIndex : *FoundSlots )
+	{
+		NumActive += Slots[ SlotIndex ].State == EBUITweenSlotState::Active ? 1 : 0;
+	}
+	for ( int32 SlotIndex : *FoundSlots )
+	{
+		const FBUITweenSlot& Slot = Slots[ SlotIndex ];
+		if ( Slot.State == EBUITweenSlotState::Active )
+		{
+			Headers[ Slot.HeaderIndex ].bSharesWidget = NumActive > 1;
+		}
+	}
+}
+
+
+int32 FBUITweenStorage::Clear( UWidget* pInWidget )
+{
+	const TArray< int32, TInlineAllocator<2> >* FoundSlots = WidgetSlots.Find( FObjectKey( pInWidget ) );
+	if ( !FoundSlots || !IsValid( pInWidget ) )
+	{
+		return 0;
+	}
+	return ClearSlots( *FoundSlots, FObjectKey( pInWidget ) );
+}
+
+
+int32 FBUITweenStorage::Clear( const TSharedRef<SWidget>& InWidget )
+{
+	const TArray< int32, TInlineAllocator<2> >* FoundSlots = SlateWidgetSlots.Find( &InWidget.Get() );
+	return FoundSlots ? ClearSlots( *FoundSlots ) : 0;
+}
+
+
+int32 FBUITweenStorage::ClearSlots( const TArray< int32, TInlineAllocator<2> > SlotIndices, const FObjectKey& WidgetKey )
+{
+	int32 NumRemoved = 0;
+	for ( int32 SlotIndex : SlotIndices )
+	{
+		FBUITweenSlot& Slot = Slots[ SlotIndex ];
+		const bool bIsLive = Slot.State == EBUITweenSlotState::Pending
+			|| ( Slot.State == EBUITweenSlotState::Active && !Headers[ Slot.HeaderIndex ].bIsCancelled );
+		if ( Slot.Stagger.IsValid() && WidgetKey != FObjectKey() )
+		{
+			// A staggered group only lets go of this widget, the rest of its elements carry on
+			if ( bIsLive && Slot.Stagger->StopElement( WidgetKey ) )
+			{
+				++NumRemoved;
+			}
+			RemoveFromWidgetIndex( WidgetKey, SlotIndex );
+		}
+		else if ( Slot.State == EBUITweenSlotState::Pending )
+		{
+			FreeSlot( SlotIndex );
+			++NumRemoved;
+		}
+		else if ( Slot.State == EBUITweenSlotState::Active && !Headers[ Slot.HeaderIndex ].bIsCancelled )
+		{
+			CancelActive( Slot.HeaderIndex );
+			++NumRemoved;
+		}
+	}
+
+	return NumRemoved;
+}
+
+
+bool FBUITweenStorage::Contains( UWidget* pInWidget ) const
+{
+	const TArray< int32, TInlineAllocator<2> >* FoundSlots = WidgetSlots.Find( FObjectKey( pInWidget ) );
+	if ( FoundSlots )
+	{
+		for ( int32 SlotIndex : *FoundSlots )
+		{
+			const FBUITweenSlot& Slot = Slots[ SlotIndex ];
+			if ( Slot.State == EBUITweenSlotState::Active && !Headers[ Slot.HeaderIndex ].bIsCancelled )
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+
+void FBUITweenStorage::Empty()
+{
+	// The slots and their generations go, so handles from before would resolve to whatever reuses them
+	GetRegisteredStorages().Remove( Id );
+	Id = AllocateStorageId();
+	GetRegisteredStorages().Add( Id, this );
+
+	Headers.Empty();
+	Springs.Empty();
+	for ( int32 Channel = 0; Channel < static_cast<int32>( EBUITweenChannel::Num ); ++Channel )
+	{
+		GetChannel( static_cast<EBUITweenChannel>( Channel ) ).Empty();
+	}
+
+	Slots.Empty();
+	FreeSlots.Empty();
+	WidgetSlots.Empty();
+	SlateWidgetSlots.Empty();
+	PendingHandles.Empty();
+	Events.Empty();
+	DispatchingEvents.Empty();
+	WidgetWrites.Empty();
+	WidgetWriteIndices.Empty();
+	ScrollChecks.Empty();
+	HiddenChecks.Empty();
+	AncestorChain.Empty();
+	WidgetsToFind.Empty();
+	FoundGeometries.Empty();
+}
+
+
+void FBUITweenStorage::Reserve( int32 Number )
+{
+	Headers.Reserve( Number );
+	Springs.Reserve( Number );
+	for ( int32 Channel = 0; Channel < static_cast<int32>( EBUITweenChannel::Num ); ++Channel )
+	{
+		GetChannel( static_cast<EBUITweenChannel>( Channel ) ).Reserve( Number );
+	}
+
+	// Slots are handed out from the back of the free list, so push them in reverse to use the low indices first
+	FreeSlots.Reserve( Number );
+	const int32 NumSlots = Slots.Num();
+	if ( NumSlots < Number )
+	{
+		Slots.Add( Number - NumSlots );
+		for ( int32 SlotIndex = Number - 1; SlotIndex >= NumSlots; --SlotIndex )
+		{
+			FreeSlots.Add( SlotIndex );
+		}
+	}
+
+	WidgetSlots.Reserve( Number );
+	SlateWidgetSlots.Reserve( Number );
+	PendingHandles.Reserve( Number );
+	Events.Reserve( Number );
+	DispatchingEvents.Reserve( Number );
+	WidgetWrites.Reserve( Number );
+	WidgetWriteIndices.Reserve( Number );
+	ScrollChecks.Reserve( Number );
+	HiddenChecks.Reserve( Number );
+	WidgetsToFind.Reserve( Number );
+	FoundGeometries.Reserve( Number );
+
+	const int32 NumChunks = FMath::DivideAndRoundUp( Number, EvaluateChunkSize );
+	ChannelWork.Reserve( NumChunks * static_cast<int32>( EBUITweenChannel::Num ) );
+	EaseWork.Reserve( NumChunks + FBUIEasing::NumTypes );
+	EaseHeaderIndices.Reserve( Number );
+	EaseTimes.Reserve( Number );
+	EaseDurations.Reserve( Number );
+	EaseParams.Reserve( Number );
+	EaseValues.Reserve( Number );
+	EaseTables.Reserve( Number );
+}
+
+
+SIZE_T FBUITweenStorage::GetHeaderAllocatedSize() const
+{
+	return Headers.GetAllocatedSize() + Springs.GetAllocatedSize();
+}
+
+
+SIZE_T FBUITweenStorage::GetChannelAllocatedSize() const
+{
+	SIZE_T Size = 0;
+	for ( int32 Channel = 0; Channel < static_cast<int32>( EBUITweenChannel::Num ); ++Channel )
+	{
+		Size += GetChannel( static_cast<EBUITweenChannel>( Channel ) ).GetAllocatedSize();
+	}
+	return Size;
+}
+
+
+SIZE_T FBUITweenStorage::GetInstanceAllocatedSize() const
+{
+	return Slots.GetAllocatedSize()
+		+ FreeSlots.GetAllocatedSize()
+		+ WidgetSlots.GetAllocatedSize()
+		+ SlateWidgetSlots.GetAllocatedSize()
+		+ PendingHandles.GetAllocatedSize()
+		+ ChannelWork.GetAllocatedSize()
+		+ EaseWork.GetAllocatedSize()
+		+ EaseHeaderIndices.GetAllocatedSize()
+		+ EaseTimes.GetAllocatedSize()
+		+ EaseDurations.GetAllocatedSize()
+		+ EaseParams.GetAllocatedSize()
+		+ EaseValues.GetAllocatedSize()
+		+ EaseTables.GetAllocatedSize()
+		+ WidgetWrites.GetAllocatedSize()
+		+ WidgetWriteIndices.GetAllocatedSize()
+		+ ScrollChecks.GetAllocatedSize()
+		+ HiddenChecks.GetAllocatedSize()
+		+ AncestorChain.GetAllocatedSize()
+		+ WidgetsToFind.GetAllocatedSize()
+		+ FoundGeometries.GetAllocatedSize()
+		+ Events.GetAllocatedSize()
+		+ DispatchingEvents.GetAllocatedSize();
+}
+
+
+FBUITweenInstance* FBUITweenStorage::Find( const FBUITweenHandle& Handle )
+{
+	FBUITweenSlot* Slot = GetSlot( Handle );
+	return Slot && Slot->State == EBUITweenSlotState::Pending ? &Slot->Instance : nullptr;
+}
+
+
+bool FBUITweenStorage::IsPending( const FBUITweenHandle& Handle ) const
+{
+	const FBUITweenSlot* Slot = GetSlot( Handle );
+	return Slot && Slot->State == EBUITweenSlotState::Pending;
+}
+
+
+FBUITweenHandle FBUITweenStorage::FindHandle( UWidget* pInWidget ) const
+{
+	const TArray< int32, TInlineAllocator<2> >* FoundSlots = WidgetSlots.Find( FObjectKey( pInWidget ) );
+	if ( !FoundSlots )
+	{
+		return FBUITweenHandle();
+	}
+
+	for ( int32 i = FoundSlots->Num() - 1; i >= 0; --i )
+	{
+		// Retargeting a staggered group would move every element, so only the widget's own tweens count
+		const FBUITweenSlot& Slot = Slots[ ( *FoundSlots )[ i ] ];
+		if ( Slot.Stagger.IsValid() )
+		{
+			continue;
+		}
+		if ( Slot.State == EBUITweenSlotState::Pending || ( Slot.State == EBUITweenSlotState::Active && !Headers[ Slot.HeaderIndex ].bIsCancelled ) )
+		{
+			return Slot.Instance.Handle;
+		}
+	}
+	return FBUITweenHandle();
+}
+
+
+bool FBUITweenStorage::Rebase( const FBUITweenHandle& Handle )
+{
+	FBUITweenSlot* Slot = GetSlot( Handle );
+	if ( !Slot || Slot->State == EBUITweenSlotState::Completing )
+	{
+		return false;
+	}
+	if ( Slot->State != EBUITweenSlotState::Active )
+	{
+		// Nothing has moved yet, the new targets go straight into the instance
+		return true;
+	}
+
+	FBUITweenHeader& Header = Headers[ Slot->HeaderIndex ];
+	if ( Header.bIsComplete || Header.bIsGroup )
+	{
+		return false;
+	}
+	if ( Header.bIsSpring || !Header.bHasStarted )
+	{
+		return true;
+	}
+
+	// Rate of change of the eased alpha and of the velocity weight where the tween is now, per second
+	float EaseSlope = 0;
+	if ( Header.Duration > 0 )
+	{
+		const float Param = Header.bHasEasingParam ? Header.EasingParam : FBUIEasing::DefaultParam;
+		const float Step = Header.Duration * 0.001f;
+		const float Before = FMath::Max( Header.GetCycleTime() - Step, 0.0f );
+		const float After = FMath::Min( Header.GetCycleTime() + Step, Header.Duration );
+		EaseSlope = ( FBUIEasing::Ease( Header.EasingType, After, Header.Duration, Param ) - FBUIEasing::Ease( Header.EasingType, Before, Header.Duration, Param ) ) / ( After - Before );
+		// The way back of a ping-pong runs the curve backwards
+		EaseSlope = Header.bIsReversed ? -EaseSlope : EaseSlope;
+	}
+	float VelocitySlope = 0;
+	if ( Header.bCarriesVelocity && Header.Duration > 0 )
+	{
+		// Derivative of the Hermite basis s * ( 1 - s )^2 that VelocityWeight follows
+		const float S = Header.Alpha / Header.Duration;
+		VelocitySlope = ( 1 - S ) * ( 1 - 3 * S );
+	}
+
+	// Values straight from the curve rather than CurrentValue, which only follows within the epsilons
+	auto RebaseChannel = [ &Header, EaseSlope, VelocitySlope ]( EBUITweenChannel Channel, auto& Storage )
+	{
+		if ( Header.HasChannel( Channel ) )
+		{
+			const int32 First = Header.ChannelIndices[ static_cast<int32>( Channel ) ];
+			for ( int32 Index = First; Index < First + Header.NumEntries( Channel ); ++Index )
+			{
+				auto& Entry = Storage.Entries[ Index ];
+				auto& Velocity = Storage.Velocities[ Index ];
+				auto& Cursor = Storage.KeyCursors[ Index ];
+				if ( Cursor.pKeys )
+				{
+					// The slope of the keys where the tween is now, after that it's a plain lerp to the last key
+					const float Step = 0.001f;
+					int32 Next = Cursor.Next;
+					const auto Value = Cursor.pKeys->Evaluate( Entry.StartValue, Header.EasedAlpha, Next );
+					const auto Before = Cursor.pKeys->Evaluate( Entry.StartValue, Header.EasedAlpha - Step, Next );
+					const auto After = Cursor.pKeys->Evaluate( Entry.StartValue, Header.EasedAlpha + Step, Next );
+					Velocity = ( After - Before ) * ( EaseSlope / ( 2 * Step ) );
+					Entry.StartValue = Value;
+					Cursor.pKeys = nullptr;
+					continue;
+				}
+				const auto Carried = Velocity - ( Entry.TargetValue - Entry.StartValue ) * Header.EaseStartSlope;
+				const auto Value = FMath::Lerp( Entry.StartValue, Entry.TargetValue, Header.EasedAlpha ) + Carried * Header.VelocityWeight;
+				Velocity = ( Entry.TargetValue - Entry.StartValue ) * EaseSlope + Carried * VelocitySlope;
+				Entry.StartValue = Value;
+			}
+		}
+	};
+	RebaseChannel( EBUITweenChannel::Translation, TranslationChannel );
+	RebaseChannel( EBUITweenChannel::Scale, ScaleChannel );
+	RebaseChannel( EBUITweenChannel::Rotation, RotationChannel );
+	RebaseChannel( EBUITweenChannel::Opacity, OpacityChannel );
+	RebaseChannel( EBUITweenChannel::Color, ColorChannel );
+	RebaseChannel( EBUITweenChannel::CanvasPosition, CanvasPositionChannel );
+	RebaseChannel( EBUITweenChannel::Padding, PaddingChannel );
+	RebaseChannel( EBUITweenChannel::MaxDesiredHeight, MaxDesiredHeightChannel );
+	RebaseChannel( EBUITweenChannel::MaterialParameter, MaterialParameterChannel );
+	RebaseChannel( EBUITweenChannel::Property, PropertyChannel );
+	if ( Header.HasChannel( EBUITweenChannel::Visibility ) )
+	{
+		auto& Entry = VisibilityChannel.Entries[ Header.ChannelIndices[ static_cast<int32>( EBUITweenChannel::Visibility ) ] ];
+		Entry.StartValue = Entry.CurrentValue;
+	}
+
+	// The easing carries on from the new start, the Hermite term adds whatever velocity its curve doesn't
+	// already leave with and fades out before the end, so the tween still lands the way its easing does
+	Header.Alpha = 0;
+	Header.EasedAlpha = 0;
+	Header.bIsReversed = false;
+	Header.VelocityWeight = 0;
+	Header.bCarriesVelocity = true;
+	PrepareEaseStartSlope( Header );
+	return true;
+}
+
+
+bool FBUITweenStorage::SetDuration( const FBUITweenHandle& Handle, float InDuration )
+{
+	FBUITweenSlot* Slot = GetSlot( Handle );
+	if ( !Slot || Slot->State == EBUITweenSlotState::Completing || Slot->Sequence.IsValid() || Slot->Stagger.IsValid() )
+	{
+		return false;
+	}
+
+	Slot->Instance.Duration = FMath::Max( InDuration, 0.0f );
+	if ( Slot->State == EBUITweenSlotState::Active )
+	{
+		Headers[ Slot->HeaderIndex ].Duration = Slot->Instance.Duration;
+		PrepareEasingTable( Headers[ Slot->HeaderIndex ] );
+		PrepareEaseStartSlope( Headers[ Slot->HeaderIndex ] );
+	}
+	return true;
+}
+
+
+bool FBUITweenStorage::SetEasing( const FBUITweenHandle& Handle, EBUIEasingType InType, TOptional<float> InEasingParam )
+{
+	FBUITweenSlot* Slot = GetSlot( Handle );
+	if ( !Slot || Slot->State == EBUITweenSlotState::Completing || Slot->Sequence.IsValid() )
+	{
+		return false;
+	}
+
+	Slot->Instance.Easing( InType, InEasingParam );
+	if ( Slot->State == EBUITweenSlotState::Active && !Slot->Stagger.IsValid() )
+	{
+		FBUITweenHeader& Header = Headers[ Slot->HeaderIndex ];
+		Header.EasingType = InType;
+		Header.bHasEasingParam = InEasingParam.IsSet();
+		Header.EasingParam = InEasingParam.Get( 0 );
+		PrepareEasingTable( Header );
+		PrepareEaseStartSlope( Header );
+	}
+	return true;
+}
+
+
+bool FBUITweenStorage::IsTweening( const FBUITweenHandle& Handle ) const
+{
+	const FBUITweenSlot* Slot = GetSlot( Handle );
+	if ( !Slot )
+	{
+		return false;
+	}
+	if ( Slot->State == EBUITweenSlotState::Active )
+	{
+		return !Headers[ Slot->HeaderIndex ].bIsCancelled;
+	}
+	return Slot->State == EBUITweenSlotState::Pending;
+}
+
+
+bool FBUITweenStorage::SetPaused( const FBUITweenHandle& Handle, bool bInIsPaused )
+{
+	FBUITweenSlot* Slot = GetSlot( Handle );
+	if ( !Slot || Slot->State == EBUITweenSlotState::Completing )
+	{
+		return false;
+	}
+	Slot->Instance.bIsPaused = bInIsPaused;
+	if ( Slot->State == EBUITweenSlotState::Active )
+	{
+		Headers[ Slot->HeaderIndex ].bIsPaused = bInIsPaused;
+	}
+	return true;
+}
+
+
+bool FBUITweenStorage::Cancel( const FBUITweenHandle& Handle )
+{
+	FBUITweenSlot* Slot = GetSlot( Handle );
+	if ( !Slot )
+	{
+		return false;
+	}
+
+	switch ( Slot->State )
+	{
+		case EBUITweenSlotState::Pending:
+			// Left in PendingHandles, the generation no longer matches so it is skipped when adding
+			FreeSlot( Handle.Index );
+			return true;
+		case EBUITweenSlotState::Active:
+			if ( Headers[ Slot->HeaderIndex ].bIsCancelled )
+			{
+				return false;
+			}
+			CancelActive( Slot->HeaderIndex );
+			return true;
+		default:
+			return false;
+	}
+}
+
+
+FBUITweenSlot* FBUITweenStorage::GetSlot( const FBUITweenHandle& Handle )
+{
+	if ( Handle.StorageId != Id || Handle.Index < 0 || Handle.Index >= Slots.Num() )
+	{
+		return nullptr;
+	}
+	FBUITweenSlot& Slot = Slots[ Handle.Index ];
+	return ( Slot.Generation == Handle.Generation && Slot.State != EBUITweenSlotState::Free ) ? &Slot : nullptr;
+}
+
+
+const FBUITweenSlot* FBUITweenStorage::GetSlot( const FBUITweenHandle& Handle ) const
+{
+	return const_cast<FBUITweenStorage*>( this )->GetSlot( Handle );
+}
+
+
+void FBUITweenStorage::FreeSlot( int32 SlotIndex )
+{
+	FBUITweenSlot& Slot = Slots[ SlotIndex ];
+
+	RemoveFromWidgetIndex( Slot.WidgetKey, SlotIndex );
+	if ( Slot.Stagger.IsValid() )
+	{
+		for ( const FBUITweenStagger::FElement& Element : Slot.Stagger->Elements )
+		{
+			RemoveFromWidgetIndex( Element.WidgetKey, SlotIndex );
+		}
+	}
+
+	TArray< int32, TInlineAllocator<2> >* SlateSlotIndices = Slot.SlateWidgetKey ? SlateWidgetSlots.Find( Slot.SlateWidgetKey ) : nullptr;
+	if ( SlateSlotIndices )
+	{
+		SlateSlotIndices->RemoveSingleSwap( SlotIndex, false );
+		if ( SlateSlotIndices->Num() == 0 )
+		{
+			SlateWidgetSlots.Remove( Slot.SlateWidgetKey );
+		}
+	}
+
+	Slot.Instance = FBUITweenInstance();
+	Slot.Sequence.Reset();
+	Slot.Stagger.Reset();
+	Slot.WidgetKey = FObjectKey();
+	Slot.SlateWidgetKey = nullptr;
+	Slot.HeaderIndex = INDEX_NONE;
+	Slot.State = EBUITweenSlotState::Free;
+	++Slot.Generation;
+	FreeSlots.Add( SlotIndex );
+}
+
+
+void FBUITweenStorage::RemoveFromWidgetIndex( const FObjectKey& WidgetKey, int32 SlotIndex )
+{
+	TArray< int32, TInlineAllocator<2> >* WidgetSlotIndices = WidgetSlots.Find( WidgetKey );
+	if ( WidgetSlotIndices )
+	{
+		WidgetSlotIndices->RemoveSingleSwap( SlotIndex, false );
+		if ( WidgetSlotIndices->Num() == 0 )
+		{
+			WidgetSlots.Remove( WidgetKey );
+		}
+	}
+}
+
+
+void FBUITweenStorage::CancelActive( int32 HeaderIndex )
+{
+	if ( bIsUpdating )
+	{
+		FBUITweenHeader& Header = Headers[ HeaderIndex ];
+		Header.bIsComplete = true;
+		Header.bIsCancelled = true;
+	}
+	else
+	{
+		const int32 SlotIndex = Headers[ HeaderIndex ].SlotIndex;
+		const FObjectKey WidgetKey = Slots[ SlotIndex ].WidgetKey;
+		RemoveAtSwap( HeaderIndex );
+		FreeSlot( SlotIndex );
+		RefreshSharesWidget( WidgetKey );
+	}
+}
+
+
+FBUITweenChannelBase& FBUITweenStorage::GetChannel( EBUITweenChannel Channel )
+{
+	switch ( Channel )
+	{
+		case EBUITweenChannel::Translation: return TranslationChannel;
+		case EBUITweenChannel::Scale: return ScaleChannel;
+		case EBUITweenChannel::Rotation: return RotationChannel;
+		case EBUITweenChannel::Opacity: return OpacityChannel;
+		case EBUITweenChannel::Color: return ColorChannel;
+		case EBUITweenChannel::Visibility: return VisibilityChannel;
+		case EBUITweenChannel::CanvasPosition: return CanvasPositionChannel;
+		case EBUITweenChannel::Padding: return PaddingChannel;
+		case EBUITweenChannel::MaxDesiredHeight: return MaxDesiredHeightChannel;
+		case EBUITweenChannel::MaterialParameter: return MaterialParameterChannel;
+		case EBUITweenChannel::Property: return PropertyChannel;
+	}
+	checkNoEntry();
+	return OpacityChannel;
+}
+
+
+void FBUITweenStorage::RemoveAtSwap( int32 Index )
+{
+	// Drop this tween's channel entries, re-pointing whichever entry took each one's place
+	const FBUITweenHeader& Header = Headers[ Index ];
+	for ( int32 Channel = 0; Channel < static_cast<int32>( EBUITweenChannel::Num ); ++Channel )
+	{
+		const int32 NumEntries = Header.NumEntries( static_cast<EBUITweenChannel>( Channel ) );
+		for ( int32 i = 0; i < NumEntries; ++i )
+		{
+			const int32 EntryIndex = Header.ChannelIndices[ Channel ] + i;
+			const int32 MovedOwner = GetChannel( static_cast<EBUITweenChannel>( Channel ) ).RemoveAtSwap( EntryIndex );
+			if ( MovedOwner != INDEX_NONE )
+			{
+				Headers[ MovedOwner ].ChannelIndices[ Channel ] = EntryIndex;
+			}
+		}
+	}
+
+	if ( Header.bIsSpring )
+	{
+		Springs.RemoveAtSwap( Header.SpringIndex, 1, false );
+		if ( Springs.IsValidIndex( Header.SpringIndex ) )
+		{
+			Headers[ Springs[ Header.SpringIndex ].Owner ].SpringIndex = Header.SpringIndex;
+		}
+	}
+
+	// The last header is about to move into Index, so its entries need to point there instead
+	const int32 LastIndex = Headers.Num() - 1;
+	if ( Index != LastIndex )
+	{
+		const FBUITweenHeader& Moved = Headers[ LastIndex ];
+		if ( Moved.bIsSpring )
+		{
+			Springs[ Moved.SpringIndex ].Owner = Index;
+		}
+		for ( int32 Channel = 0; Channel < static_cast<int32>( EBUITweenChannel::Num ); ++Channel )
+		{
+			const int32 NumEntries = Moved.NumEntries( static_cast<EBUITweenChannel>( Channel ) );
+			for ( int32 i = 0; i < NumEntries; ++i )
+			{
+				GetChannel( static_cast<EBUITweenChannel>( Channel ) ).SetOwner( Moved.ChannelIndices[ Channel ] + i, Index );
+			}
+		}
+	}
+
+	Headers.RemoveAtSwap( Index, 1, false );
+	if ( Headers.IsValidIndex( Index ) )
+	{
+		Slots[ Headers[ Index ].SlotIndex ].HeaderIndex = Index;
+	}
+}
@@ -0,0 +1,206 @@
+#include "BUITweenSubsystem.h"
+#include "BUITweenSettings.h"
+#include "BUITweenStats.h"
+#include "Engine/World.h"
+
+UBUITweenSubsystem* UBUITweenSubsystem::Get( const UObject* WorldContextObject )
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UBUITweenSubsystem>() : nullptr;
+}
+
+
+void UBUITweenSubsystem::Initialize( FSubsystemCollectionBase& Collection )
+{
+	Super::Initialize( Collection );
+
+	const UBUITweenSettings* Settings = GetDefault<UBUITweenSettings>();
+	FindOrAddGroup( NAME_None ).Storage->Reserve( Settings->ReservedTweenCapacity );
+	for ( const TPair< FName, FBUITweenGroupSettings >& Pair : Settings->TweenGroups )
+	{
+		FindOrAddGroup( Pair.Key ).Settings = Pair.Value;
+	}
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject( this, &UBUITweenSubsystem::OnWorldPreActorTick );
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject( this, &UBUITweenSubsystem::OnWorldPostActorTick );
+}
+
+
+void UBUITweenSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove( PreActorTickHandle );
+	FWorldDelegates::OnWorldPostActorTick.Remove( PostActorTickHandle );
+
+	// Callbacks of tweens still running never fire, same as a cancel
+	Groups.Empty();
+
+	Super::Deinitialize();
+}
+
+
+UBUITweenSubsystem::FGroup* UBUITweenSubsystem::FindGroup( FName InGroup )
+{
+	return Groups.FindByPredicate( [ InGroup ]( const FGroup& Group ) { return Group.Name == InGroup; } );
+}
+
+
+const UBUITweenSubsystem::FGroup* UBUITweenSubsystem::FindGroup( FName InGroup ) const
+{
+	return const_cast<UBUITweenSubsystem*>( this )->FindGroup( InGroup );
+}
+
+
+UBUITweenSubsystem::FGroup& UBUITweenSubsystem::FindOrAddGroup( FName InGroup )
+{
+	if ( FGroup* Found = FindGroup( InGroup ) )
+	{
+		return *Found;
+	}
+
+	FGroup& Group = Groups.AddDefaulted_GetRef();
+	Group.Name = InGroup;
+	Group.Storage = MakeUnique<FBUITweenStorage>();
+	return Group;
+}
+
+
+FBUITweenStorage& UBUITweenSubsystem::GetStorage( FName InGroup )
+{
+	return *FindOrAddGroup( InGroup ).Storage;
+}
+
+
+void UBUITweenSubsystem::ConfigureGroup( FName InGroup, const FBUITweenGroupSettings& InSettings )
+{
+	FindOrAddGroup( InGroup ).Settings = InSettings;
+}
+
+
+const FBUITweenGroupSettings* UBUITweenSubsystem::GetGroupSettings( FName InGroup ) const
+{
+	const FGroup* Group = FindGroup( InGroup );
+	return Group ? &Group->Settings : nullptr;
+}
+
+
+void UBUITweenSubsystem::SetGroupPaused( FName InGroup, bool bInIsPaused )
+{
+	FindOrAddGroup( InGroup ).bIsPaused = bInIsPaused;
+}
+
+
+bool UBUITweenSubsystem::IsGroupPaused( FName InGroup ) const
+{
+	const FGroup* Group = FindGroup( InGroup );
+	return Group && Group->bIsPaused;
+}
+
+
+void UBUITweenSubsystem::SetGroupTimeScale( FName InGroup, float InTimeScale )
+{
+	FindOrAddGroup( InGroup ).Settings.TimeScale = FMath::Max( InTimeScale, 0.0f );
+}
+
+
+int32 UBUITweenSubsystem::Clear( UWidget* pInWidget )
+{
+	int32 NumRemoved = 0;
+	for ( FGroup& Group : Groups )
+	{
+		NumRemoved += Group.Storage->Clear( pInWidget );
+	}
+	return NumRemoved;
+}
+
+
+bool UBUITweenSubsystem::Contains( UWidget* pInWidget ) const
+{
+	for ( const FGroup& Group : Groups )
+	{
+		if ( Group.Storage->Contains( pInWidget ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+FBUITweenHandle UBUITweenSubsystem::FindHandle( UWidget* pInWidget ) const
+{
+	for ( const FGroup& Group : Groups )
+	{
+		const FBUITweenHandle Handle = Group.Storage->FindHandle( pInWidget );
+		if ( Handle.IsValid() )
+		{
+			return Handle;
+		}
+	}
+	return FBUITweenHandle();
+}
+
+
+void UBUITweenSubsystem::Tick( float DeltaTime )
+{
+	Super::Tick( DeltaTime );
+
+	UpdatePhase( EBUITweenTickPhase::EndOfFrame );
+
+	// Groups that deferred their callbacks fire them here, after every phase has updated
+	for ( int32 i = 0; i < Groups.Num(); ++i )
+	{
+		if ( Groups[ i ].Storage->HasEvents() )
+		{
+			Groups[ i ].Storage->DispatchEvents();
+		}
+	}
+}
+
+
+void UBUITweenSubsystem::OnWorldPreActorTick( UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds )
+{
+	if ( InWorld == GetWorld() )
+	{
+		UpdatePhase( EBUITweenTickPhase::PreActorTick );
+	}
+}
+
+
+void UBUITweenSubsystem::OnWorldPostActorTick( UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds )
+{
+	if ( InWorld == GetWorld() )
+	{
+		UpdatePhase( EBUITweenTickPhase::PostActorTick );
+	}
+}
+
+
+void UBUITweenSubsystem::UpdatePhase( EBUITweenTickPhase Phase )
+{
+	BUITWEEN_SCOPE( Update );
+
+	const UWorld* World = GetWorld();
+	const bool bIsGamePaused = World->IsPaused();
+
+	for ( int32 i = 0; i < Groups.Num(); ++i )
+	{
+		FGroup& Group = Groups[ i ];
+		const FBUITweenGroupSettings& Settings = Group.Settings;
+		if ( Settings.TickPhase != Phase || Group.bIsPaused || ( Settings.bPauseWithGame && bIsGamePaused ) )
+		{
+			continue;
+		}
+
+		// The real delta is what the module used to pass every tween before there were groups
+		// Callbacks may add groups, so nothing in Group is read after the update
+		const float DeltaTime = Settings.bUseTimeDilation ? World->GetDeltaSeconds() : World->DeltaRealTimeSeconds;
+		Group.Storage->SetDeferEvents( Settings.bDeferCallbacks );
+		Group.Storage->Update( DeltaTime * Settings.TimeScale );
+	}
+}
+
+
+bool UBUITweenSubsystem::DoesSupportWorldType( const EWorldType::Type WorldType ) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::GamePreview;
+}
@@ -0,0 +1,240 @@
+#include "BUITweenTargets.h"
+
+#include "Components/Image.h"
+#include "Components/Border.h"
+#include "Components/CanvasPanelSlot.h"
+#include "Components/OverlaySlot.h"
+#include "Components/VerticalBoxSlot.h"
+#include "Components/HorizontalBoxSlot.h"
+#include "Components/SizeBox.h"
+#include "Blueprint/UserWidget.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Widgets/SWidget.h"
+
+void FBUITweenTargets::Resolve( UWidget* pWidget )
+{
+	if ( pWidget->IsA<UUserWidget>() )
+	{
+		ColorTarget = EBUITweenColorTarget::UserWidget;
+	}
+	else if ( pWidget->IsA<UImage>() )
+	{
+		ColorTarget = EBUITweenColorTarget::Image;
+	}
+	else if ( pWidget->IsA<UBorder>() )
+	{
+		ColorTarget = EBUITweenColorTarget::Border;
+	}
+	else
+	{
+		ColorTarget = EBUITweenColorTarget::None;
+	}
+
+	bIsSizeBox = pWidget->IsA<USizeBox>();
+
+	ResolveSlot( pWidget->Slot );
+}
+
+void FBUITweenTargets::ResolveSlot( UPanelSlot* pInSlot )
+{
+	pSlot = pInSlot;
+
+	if ( !pInSlot )
+	{
+		SlotTarget = EBUITweenSlotTarget::None;
+	}
+	else if ( pInSlot->IsA<UCanvasPanelSlot>() )
+	{
+		SlotTarget = EBUITweenSlotTarget::CanvasPanel;
+	}
+	else if ( pInSlot->IsA<UOverlaySlot>() )
+	{
+		SlotTarget = EBUITweenSlotTarget::Overlay;
+	}
+	else if ( pInSlot->IsA<UHorizontalBoxSlot>() )
+	{
+		SlotTarget = EBUITweenSlotTarget::HorizontalBox;
+	}
+	else if ( pInSlot->IsA<UVerticalBoxSlot>() )
+	{
+		SlotTarget = EBUITweenSlotTarget::VerticalBox;
+	}
+	else
+	{
+		SlotTarget = EBUITweenSlotTarget::None;
+	}
+}
+
+UPanelSlot* FBUITweenTargets::GetSlot( UWidget* pWidget )
+{
+	UPanelSlot* CurrentSlot = pWidget->Slot;
+	if ( pSlot.Get() != CurrentSlot )
+	{
+		ResolveSlot( CurrentSlot );
+	}
+	return CurrentSlot;
+}
+
+bool FBUITweenTargets::GetColor( UWidget* pWidget, FLinearColor& OutColor ) const
+{
+	switch ( ColorTarget )
+	{
+		case EBUITweenColorTarget::UserWidget:
+			OutColor = static_cast<UUserWidget*>( pWidget )->GetColorAndOpacity();
+			return true;
+		case EBUITweenColorTarget::Image:
+			OutColor = static_cast<UImage*>( pWidget )->GetColorAndOpacity();
+			return true;
+		case EBUITweenColorTarget::Border:
+			OutColor = static_cast<UBorder*>( pWidget )->GetContentColorAndOpacity();
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool FBUITweenTargets::GetCanvasPosition( UWidget* pWidget, FVector2D& OutPosition )
+{
+	UPanelSlot* CurrentSlot = GetSlot( pWidget );
+	if ( SlotTarget == EBUITweenSlotTarget::CanvasPanel )
+	{
+		OutPosition = static_cast<UCanvasPanelSlot*>( CurrentSlot )->GetPosition();
+		return true;
+	}
+	return false;
+}
+
+bool FBUITweenTargets::GetPadding( UWidget* pWidget, FMargin& OutPadding )
+{
+	UPanelSlot* CurrentSlot = GetSlot( pWidget );
+	switch ( SlotTarget )
+	{
+		case EBUITweenSlotTarget::Overlay:
+			OutPadding = static_cast<UOverlaySlot*>( CurrentSlot )->GetPadding();
+			return true;
+		case EBUITweenSlotTarget::HorizontalBox:
+			OutPadding = static_cast<UHorizontalBoxSlot*>( CurrentSlot )->GetPadding();
+			return true;
+		case EBUITweenSlotTarget::VerticalBox:
+			OutPadding = static_cast<UVerticalBoxSlot*>( CurrentSlot )->GetPadding();
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool FBUITweenTargets::GetMaxDesiredHeight( UWidget* pWidget, float& OutHeight ) const
+{
+	if ( bIsSizeBox )
+	{
+		OutHeight = static_cast<USizeBox*>( pWidget )->GetMaxDesiredHeight();
+		return true;
+	}
+	return false;
+}
+
+void FBUITweenTargets::SetColor( UWidget* pWidget, const FLinearColor& InColor ) const
+{
+	switch ( ColorTarget )
+	{
+		case EBUITweenColorTarget::UserWidget:
+			static_cast<UUserWidget*>( pWidget )->SetColorAndOpacity( InColor );
+			break;
+		case EBUITweenColorTarget::Image:
+			static_cast<UImage*>( pWidget )->SetColorAndOpacity( InColor );
+			break;
+		case EBUITweenColorTarget::Border:
+			static_cast<UBorder*>( pWidget )->SetContentColorAndOpacity( InColor );
+			break;
+		default:
+			break;
+	}
+}
+
+void FBUITweenTargets::SetCanvasPosition( UWidget* pWidget, const FVector2D& InPosition )
+{
+	UPanelSlot* CurrentSlot = GetSlot( pWidget );
+	if ( SlotTarget == EBUITweenSlotTarget::CanvasPanel )
+	{
+		static_cast<UCanvasPanelSlot*>( CurrentSlot )->SetPosition( InPosition );
+	}
+}
+
+void FBUITweenTargets::SetPadding( UWidget* pWidget, const FMargin& InPadding )
+{
+	UPanelSlot* CurrentSlot = GetSlot( pWidget );
+	switch ( SlotTarget )
+	{
+		case EBUITweenSlotTarget::Overlay:
+			static_cast<UOverlaySlot*>( CurrentSlot )->SetPadding( InPadding );
+			break;
+		case EBUITweenSlotTarget::HorizontalBox:
+			static_cast<UHorizontalBoxSlot*>( CurrentSlot )->SetPadding( InPadding );
+			break;
+		case EBUITweenSlotTarget::VerticalBox:
+			static_cast<UVerticalBoxSlot*>( CurrentSlot )->SetPadding( InPadding );
+			break;
+		default:
+			break;
+	}
+}
+
+void FBUITweenTargets::SetMaxDesiredHeight( UWidget* pWidget, float InHeight ) const
+{
+	if ( bIsSizeBox )
+	{
+		static_cast<USizeBox*>( pWidget )->SetMaxDesiredHeight( InHeight );
+	}
+}
+
+UMaterialInstanceDynamic* FBUITweenTargets::GetDynamicMaterial( UWidget* pWidget ) const
+{
+	switch ( ColorTarget )
+	{
+		case EBUITweenColorTarget::Image:
+			return static_cast<UImage*>( pWidget )->GetDynamicMaterial();
+		case EBUITweenColorTarget::Border:
+			return static_cast<UBorder*>( pWidget )->GetDynamicMaterial();
+		default:
+			return nullptr;
+	}
+}
+
+void FBUITweenTargets::SetMaterialParameter( UMaterialInstanceDynamic* pMaterial, FName InName, bool bIsVector, int32& InOutParameterIndex, const FLinearColor& InValue )
+{
+	if ( bIsVector )
+	{
+		if ( !pMaterial->SetVectorParameterByIndex( InOutParameterIndex, InValue ) )
+		{
+			pMaterial->InitializeVectorParameterAndGetIndex( InName, InValue, InOutParameterIndex );
+		}
+	}
+	else if ( !pMaterial->SetScalarParameterByIndex( InOutParameterIndex, InValue.R ) )
+	{
+		pMaterial->InitializeScalarParameterAndGetIndex( InName, InValue.R, InOutParameterIndex );
+	}
+}
+
+FWidgetTransform FBUITweenTargets::GetSlateRenderTransform( const SWidget& InWidget )
+{
+	FWidgetTransform Transform;
+	const TOptional<FSlateRenderTransform>& RenderTransform = InWidget.GetRenderTransform();
+	if ( !RenderTransform.IsSet() )
+	{
+		return Transform;
+	}
+
+	// Scale then rotation, so the matrix rows are ( Sx cos, Sx sin ) and ( -Sy sin, Sy cos )
+	float A, B, C, D;
+	RenderTransform->GetMatrix().GetMatrix( A, B, C, D );
+	const float ScaleX = FMath::Sqrt( A * A + B * B );
+	Transform.Translation = FVector2D( RenderTransform->GetTranslation() );
+	Transform.Angle = FMath::RadiansToDegrees( FMath::Atan2( B, A ) );
+	Transform.Scale = FVector2D( ScaleX, ScaleX > 0 ? ( A * D - B * C ) / ScaleX : FMath::Sqrt( C * C + D * D ) );
+	return Transform;
+}
+
+void FBUITweenTargets::SetSlateRenderTransform( SWidget& InWidget, const FWidgetTransform& InTransform )
+{
+	InWidget.SetRenderTransform( InTransform.ToSlateRenderTransform() );
+}
@@ -0,0 +1,60 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BUIEasing.h"
+#include "BUIEasingLUT.h"
+#include "BUITweenSettings.h"
+#include "../BUITweenBenchmark.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUIEasingBatchTest, "BUITween.Easing.BatchMatchesScalar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter )
+
+bool FBUIEasingBatchTest::RunTest( const FString& Parameters )
+{
+	const BUITweenBenchmark::FEasingSamples Samples = BUITweenBenchmark::MakeEasingSamples( 4096 );
+	const UEnum* EasingEnum = StaticEnum<EBUIEasingType>();
+	for ( int32 TypeIndex = 0; TypeIndex < FBUIEasing::NumTypes; ++TypeIndex )
+	{
+		const float MaxError = BUITweenBenchmark::MeasureBatchError( static_cast<EBUIEasingType>( TypeIndex ), Samples );
+		TestTrue( FString::Printf( TEXT( "%s batch error %g within %g" ), *EasingEnum->GetNameStringByIndex( TypeIndex ), MaxError, BUITweenBenchmark::EaseBatchTolerance ),
+			MaxError <= BUITweenBenchmark::EaseBatchTolerance );
+	}
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUIEasingLUTTest, "BUITween.Easing.LUTMaxError",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter )
+
+bool FBUIEasingLUTTest::RunTest( const FString& Parameters )
+{
+	const UBUITweenSettings* Settings = GetDefault<UBUITweenSettings>();
+
+	// Our own tables so the running game's aren't rebuilt
+	FBUIEasingLUT EasingLUT;
+	EasingLUT.Configure( true, Settings->EasingLUTResolution, Settings->EasingLUTMaxError, TNumericLimits<int32>::Max() );
+
+	const UEnum* EasingEnum = StaticEnum<EBUIEasingType>();
+	for ( int32 TypeIndex = 0; TypeIndex < FBUIEasing::NumTypes; ++TypeIndex )
+	{
+		const EBUIEasingType Type = static_cast<EBUIEasingType>( TypeIndex );
+		if ( !FBUIEasingLUT::UsesTable( Type ) )
+		{
+			continue;
+		}
+
+		int32 NumAnalytic;
+		const float WorstError = BUITweenBenchmark::MeasureLUTError( EasingLUT, Type, 10000, NumAnalytic );
+		TestTrue( FString::Printf( TEXT( "%s table error %g within %g" ), *EasingEnum->GetNameStringByIndex( TypeIndex ), WorstError, Settings->EasingLUTMaxError ),
+			WorstError <= Settings->EasingLUTMaxError );
+	}
+
+	// A duration off the millisecond grid stays analytic rather than building a table mid-update
+	const int32 NumTables = EasingLUT.NumTables();
+	TestNull( TEXT( "Elastic table for an off-grid duration" ), EasingLUT.FindOrBuild( EBUIEasingType::OutElastic, 1.0f / 3.0f, FBUIEasing::DefaultParam ) );
+	TestEqual( TEXT( "Tables after an off-grid lookup" ), EasingLUT.NumTables(), NumTables );
+	return true;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BUITweenStorage.h"
+#include "Components/Image.h"
+#include "UObject/Package.h"
+#include "Widgets/SWidget.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenNestedPropertyTest, "BUITween.Property.NestedPathReachesSlate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenNestedPropertyTest::RunTest( const FString& Parameters )
+{
+	UImage* pImage = NewObject<UImage>( GetTransientPackage() );
+	const TSharedRef<SWidget> SlateWidget = pImage->TakeWidget();
+
+	// A dotted path has no setter, so it's stored into the UPROPERTY and has to be synchronized to Slate
+	FBUITweenStorage Storage;
+	Storage.Create( pImage, 0.5f, 0.0f )
+		.ToProperty( TEXT( "RenderTransform.Translation" ), FVector2D( 10, 20 ) )
+		.Begin();
+	Storage.Update( 0.0f );
+	Storage.Update( 1.0f );
+
+	TestEqual( TEXT( "UMG translation" ), pImage->GetRenderTransform().Translation, FVector2D( 10, 20 ) );
+	const TOptional<FSlateRenderTransform>& SlateTransform = SlateWidget->GetRenderTransform();
+	if ( TestTrue( TEXT( "Slate widget has a render transform" ), SlateTransform.IsSet() ) )
+	{
+		TestEqual( TEXT( "Slate translation" ), FVector2D( SlateTransform->GetTranslation() ), FVector2D( 10, 20 ) );
+	}
+
+	Storage.Empty();
+	return true;
+}
+
+#endif
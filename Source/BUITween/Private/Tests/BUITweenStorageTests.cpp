@@ -0,0 +1,32 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "BUITweenStorage.h"
+#include "Components/Image.h"
+#include "UObject/Package.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenEmptyHandleTest, "BUITween.Storage.EmptyInvalidatesHandles",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenEmptyHandleTest::RunTest( const FString& Parameters )
+{
+	UImage* pImage = NewObject<UImage>( GetTransientPackage() );
+
+	FBUITweenStorage Storage;
+	const FBUITweenHandle OldHandle = Storage.Create( pImage, 1.0f, 0.0f ).ToOpacity( 0 ).GetHandle();
+	Storage.Empty();
+
+	// The new tween gets the same slot index and generation the old one had
+	FBUITweenInstance& NewTween = Storage.Create( pImage, 1.0f, 0.0f ).ToOpacity( 1 );
+	TestEqual( TEXT( "Slot index reused" ), NewTween.GetHandle().Index, OldHandle.Index );
+	TestNull( TEXT( "Old handle after Empty" ), Storage.Find( OldHandle ) );
+	TestFalse( TEXT( "Old handle tweening after Empty" ), Storage.IsTweening( OldHandle ) );
+	TestFalse( TEXT( "Old handle cancelled after Empty" ), Storage.Cancel( OldHandle ) );
+	TestTrue( TEXT( "New handle still tweening" ), Storage.IsTweening( NewTween.GetHandle() ) );
+
+	Storage.Empty();
+	return true;
+}
+
+#endif
@@ -0,0 +1,20 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "../BUITweenBenchmark.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST( FBUITweenSteadyStateTest, "BUITween.Update.SteadyStateAllocations",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter )
+
+bool FBUITweenSteadyStateTest::RunTest( const FString& Parameters )
+{
+	for ( const int32 NumTweens : { 10, 100 } )
+	{
+		const BUITweenBenchmark::FUpdateResult Result = BUITweenBenchmark::RunSteadyStateCase( NumTweens, 300 );
+		TestEqual( FString::Printf( TEXT( "Allocations per frame with %d warm tweens" ), NumTweens ), Result.AllocationsPerFrame, 0.0 );
+	}
+	return true;
+}
+
+#endif
@@ -42,6 +42,15 @@ struct FBUIEasing
 public:
 	#define BUI_TWO_PI          (6.28318530717f)
 
+	static constexpr int32 NumTypes = static_cast<int32>( EBUIEasingType::InOutBack ) + 1;
+
+	// Default second parameter used when a tween doesn't provide one
+	static constexpr float DefaultParam = 0.1f;
+
+	// Evaluates Num samples of one easing type, four at a time with vector math, falling back to Ease()
+	// for the remainder. Params may be null to use DefaultParam. Period is always 1, as with Ease()'s default.
+	static BUITWEEN_API void EaseBatch( EBUIEasingType Type, const float* Times, const float* Durations, const float* Params, float* OutValues, int32 Num );
+
 	static float Ease( EBUIEasingType Type, float time, float duration = 1.0f, float overshootOrAmplitude = 0.1f, float period = 1.0f )
 	{
 		switch ( Type )
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+
+// One easing curve sampled at evenly spaced normalized times
+struct BUITWEEN_API FBUIEasingTable
+{
+	TArray<float> Values;
+	// Largest difference from the analytic curve found when the table was built
+	float MaxError = 0;
+
+	inline float Sample( float T ) const
+	{
+		const int32 NumIntervals = Values.Num() - 1;
+		const float X = FMath::Clamp( T, 0.0f, 1.0f ) * NumIntervals;
+		const int32 Index = FMath::Min( static_cast<int32>( X ), NumIntervals - 1 );
+		return FMath::Lerp( Values[ Index ], Values[ Index + 1 ], X - Index );
+	}
+};
+
+// Lookup tables for the easings that need Sin, Cos or Pow. Tables only depending on the type are
+// built up front, elastic ones are keyed on param and duration and back ones on param, those get
+// built the first time they're asked for.
+// Elastic durations are keyed to the millisecond, a duration off that grid like a retargeted one stays
+// analytic rather than building a table of its own.
+// Building happens on the game thread, sampling a table that was handed out is safe from any thread.
+class BUITWEEN_API FBUIEasingLUT
+{
+public:
+	static FBUIEasingLUT& Get();
+
+	// Drops every table, they'll be rebuilt with the new settings
+	void Configure( bool bInIsEnabled, int32 InResolution, float InMaxError, int32 InMaxKeyedTables );
+	void BuildStaticTables();
+	void Empty();
+
+	bool IsEnabled() const { return bIsEnabled; }
+	// Bumped whenever the tables are dropped, a table pointer kept from an older generation is dangling
+	uint32 GetGeneration() const { return Generation; }
+
+	// Polynomial easings are cheaper to evaluate than to look up, so only these get tables
+	static bool UsesTable( EBUIEasingType Type );
+	static bool IsKeyedOnDuration( EBUIEasingType Type );
+	static bool IsKeyedOnParam( EBUIEasingType Type );
+
+	// Returns nullptr when the curve couldn't fit within the max error, or too many keyed tables exist
+	const FBUIEasingTable* FindOrBuild( EBUIEasingType Type, float Duration, float Param );
+	// Never builds, for the update which only reads the tables its tweens asked for when they began
+	const FBUIEasingTable* Find( EBUIEasingType Type, float Duration, float Param ) const;
+
+	// Same results as FBUIEasing::Ease, the endpoints are always analytic so a tween still lands exactly
+	static inline float Ease( const FBUIEasingTable& Table, EBUIEasingType Type, float Time, float Duration, float Param )
+	{
+		if ( Time <= 0 || Time >= Duration )
+		{
+			return FBUIEasing::Ease( Type, Time, Duration, Param );
+		}
+		return Table.Sample( Time / Duration );
+	}
+
+	int32 NumTables() const;
+	float GetWorstError() const;
+
+protected:
+	TUniquePtr<FBUIEasingTable> Build( EBUIEasingType Type, float Duration, float Param ) const;
+
+	static constexpr float DurationQuantum = 0.001f;
+
+	struct FKey
+	{
+		EBUIEasingType Type;
+		float Duration;
+		float Param;
+
+		bool operator==( const FKey& Other ) const
+		{
+			return Type == Other.Type && Duration == Other.Duration && Param == Other.Param;
+		}
+		friend uint32 GetTypeHash( const FKey& Key )
+		{
+			return HashCombine( ::GetTypeHash( static_cast<int32>( Key.Type ) ), HashCombine( ::GetTypeHash( Key.Duration ), ::GetTypeHash( Key.Param ) ) );
+		}
+	};
+	// False when the duration is off the grid, those tweens stay analytic
+	static bool MakeKey( EBUIEasingType Type, float Duration, float Param, FKey& OutKey );
+
+	// Null entries are curves that didn't fit, so they aren't retried every frame
+	TUniquePtr<FBUIEasingTable> StaticTables[ FBUIEasing::NumTypes ];
+	bool bStaticTableBuilt[ FBUIEasing::NumTypes ] = { false };
+	TMap< FKey, TUniquePtr<FBUIEasingTable> > KeyedTables;
+	bool bHasWarnedFull = false;
+	uint32 Generation = 1;
+
+	bool bIsEnabled = false;
+	int32 Resolution = 256;
+	float MaxError = 0.001f;
+	int32 MaxKeyedTables = 128;
+};
@@ -3,6 +3,9 @@
 #include "BUIEasing.h"
 #include "Components/Widget.h"
 #include "BUITweenInstance.h"
+#include "BUITweenStorage.h"
+#include "BUITweenGroup.h"
+#include "BUITweenRetarget.h"
 #include "BUITween.generated.h"
 
 UCLASS()
@@ -14,25 +17,76 @@ public:
 	static void Startup();
 	static void Shutdown();
 
-	// Create a new tween on the target widget, does not start automatically
+	// Create a new tween on the target widget, does not start automatically. A negative delay starts it
+	// that far in.
 	static FBUITweenInstance& Create( UWidget* pInWidget, float InDuration = 1.0f, float InDelay = 0.0f, bool bIsAdditive = false );
 
+	// Create a tween in a named group of the widget's world, which sets how time advances for it. See
+	// UBUITweenSubsystem. Widgets outside a world ignore the group.
+	static FBUITweenInstance& CreateInGroup( FName InGroup, UWidget* pInWidget, float InDuration = 1.0f, float InDelay = 0.0f, bool bIsAdditive = false );
+
+	// Create a tween on a plain Slate widget, with no UWidget around it. Only translation, scale, rotation
+	// and opacity apply, written straight to the widget's render transform and opacity. Slate widgets have
+	// no world, so these tick with the global storage.
+	static FBUITweenInstance& CreateSlate( const TSharedRef<SWidget>& InWidget, float InDuration = 1.0f, float InDelay = 0.0f, bool bIsAdditive = false );
+
+	// Create a sequence of tweens on one clock, add steps to it and call Begin(). Its callbacks get a null widget.
+	// Pass a world context, such as one of its widgets, so it ticks with that world.
+	static FBUITweenSequence& CreateSequence( float InDelay = 0.0f, const UObject* WorldContextObject = nullptr );
+
+	// Create one tween played over every widget, each starting InStaggerInterval after the previous one
+	// (last to first if negative). Configure it like a single tween and call Begin(), the whole group is
+	// one entry in the update. Its callbacks fire once for the group, with a null widget.
+	static FBUITweenInstance& CreateStaggered( TArrayView<UWidget* const> InWidgets, float InDuration = 1.0f, float InStaggerInterval = 0.05f, float InDelay = 0.0f, bool bIsAdditive = false );
+
 	// Cancel all tweens on the target widget, returns the number of tween instances removed
 	static int32 Clear( UWidget* pInWidget );
+	static int32 Clear( const TSharedRef<SWidget>& InWidget );
 
+	// Updates the tweens on widgets outside any world, each world's UBUITweenSubsystem updates its own
 	static void Update( float InDeltaTime );
 
+	// The storage of a group in the context's world, or the global one if it has no world
+	static FBUITweenStorage& GetStorage( const UObject* WorldContextObject, FName InGroup = NAME_None );
+
+	static void ConfigureGroup( const UObject* WorldContextObject, FName InGroup, const FBUITweenGroupSettings& InSettings );
+	// Freezes or resumes every tween of the group at once, a paused group costs nothing per frame
+	static void SetGroupPaused( const UObject* WorldContextObject, FName InGroup, bool bInIsPaused );
+	static void SetGroupTimeScale( const UObject* WorldContextObject, FName InGroup, float InTimeScale );
+
 	static bool GetIsTweening( UWidget* pInWidget );
 
+	// Jumps every begun tween in every world to its end in a single update and fires its callbacks. Tweens
+	// created by those callbacks start on the next update.
 	static void CompleteAll();
 
+	// Returns the tween the handle refers to while it can still be set up. Its first update copies it into
+	// the running state, after that this returns nullptr and the tween is changed through the handle.
+	static FBUITweenInstance* Find( const FBUITweenHandle& Handle );
+
+	static bool GetIsTweening( const FBUITweenHandle& Handle );
+
+	static bool Pause( const FBUITweenHandle& Handle );
+	static bool Resume( const FBUITweenHandle& Handle );
+
+	// Moves the targets of a running tween in place, see FBUITweenRetarget
+	static FBUITweenRetarget Retarget( const FBUITweenHandle& Handle );
+	// Retargets the tween running on the widget, for widgets with a single tween. Check Succeeded() and
+	// Create a tween if there was none
+	static FBUITweenRetarget Retarget( UWidget* pInWidget );
+
+	// Removes the tween without firing its complete callbacks
+	static bool Cancel( const FBUITweenHandle& Handle );
+
+	// Widget writes made and avoided by the last update, and since startup, over every world
+	static FBUITweenApplyStats GetApplyStats();
+	static FBUITweenApplyStats GetTotalApplyStats();
+
 protected:
 	static bool bIsInitialized;
 
-	static TArray< FBUITweenInstance > ActiveInstances;
-
-	// We delay adding until the end of an update so we don't add to ActiveInstances within our update loop
-	static TArray< FBUITweenInstance > InstancesToAdd;
+	// Tweens on widgets that aren't in a world with a UBUITweenSubsystem
+	static FBUITweenStorage Storage;
 };
 
 
@@ -44,7 +98,12 @@ class BUITWEEN_API UBUIParamChain : public UObject
 
 public:
 
-	FBUITweenInstance* TweenInstance;
+	FBUITweenInstance* GetInstance() const
+	{
+		return UBUITween::Find(TweenHandle);
+	}
+
+	FBUITweenHandle TweenHandle;
 };
 
 UCLASS()
@@ -55,10 +114,15 @@ class BUITWEEN_API UBUITweenBlueprintFunctionLibrary : public UBlueprintFunction
 public:
 
 	UFUNCTION(BlueprintCallable, Category = UITween)
-	static void RunAnimation(UBUIParamChain* Params)
+	static FBUITweenHandle RunAnimation(UBUIParamChain* Params)
 	{
-		Params->TweenInstance->Begin();
+		const FBUITweenHandle Handle = Params->TweenHandle;
+		if (FBUITweenInstance* Tween = Params->GetInstance())
+		{
+			Tween->Begin();
+		}
 		Params->ConditionalBeginDestroy();
+		return Handle;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
@@ -66,21 +130,51 @@ public:
 	{
 		FBUITweenInstance& Tween = UBUITween::Create(InWidget, InDuration, InDelay, bIsAdditive);
 		UBUIParamChain* Params = NewObject<UBUIParamChain>(GetTransientPackage(), TEXT(""), RF_MarkAsRootSet);
-		Params->TweenInstance = &Tween;
+		Params->TweenHandle = Tween.GetHandle();
 		return Params;
 	}
 
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static bool IsAnimationRunning(const FBUITweenHandle& Handle)
+	{
+		return UBUITween::GetIsTweening(Handle);
+	}
+
+	UFUNCTION(BlueprintCallable, Category = UITween)
+	static bool PauseAnimation(const FBUITweenHandle& Handle)
+	{
+		return UBUITween::Pause(Handle);
+	}
+
+	UFUNCTION(BlueprintCallable, Category = UITween)
+	static bool ResumeAnimation(const FBUITweenHandle& Handle)
+	{
+		return UBUITween::Resume(Handle);
+	}
+
+	UFUNCTION(BlueprintCallable, Category = UITween)
+	static bool CancelAnimation(const FBUITweenHandle& Handle)
+	{
+		return UBUITween::Cancel(Handle);
+	}
+
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToTranslation(UBUIParamChain* Previous, const FVector2D& InTarget)
 	{
-		Previous->TweenInstance->ToTranslation(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToTranslation(InTarget);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromTranslation(UBUIParamChain* Previous, const FVector2D& InStart)
 	{
-		Previous->TweenInstance->FromTranslation(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromTranslation(InStart);
+		}
 		return Previous;
 	}
 
@@ -88,133 +182,360 @@ public:
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToScale(UBUIParamChain* Previous, const FVector2D& InTarget)
 	{
-		Previous->TweenInstance->ToScale(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToScale(InTarget);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromScale(UBUIParamChain* Previous, const FVector2D& InStart)
 	{
-		Previous->TweenInstance->FromScale(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromScale(InStart);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToOpacity(UBUIParamChain* Previous, const float InTarget)
 	{
-		Previous->TweenInstance->ToOpacity(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToOpacity(InTarget);
+		}
 		return Previous;
 	}
 	
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromOpacity(UBUIParamChain* Previous, const float InStart)
 	{
-		Previous->TweenInstance->FromOpacity(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromOpacity(InStart);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToColor(UBUIParamChain* Previous, const FLinearColor& InTarget)
 	{
-		Previous->TweenInstance->ToColor(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToColor(InTarget);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromColor(UBUIParamChain* Previous, const FLinearColor& InStart)
 	{
-		Previous->TweenInstance->FromColor(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromColor(InStart);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToRotation(UBUIParamChain* Previous, const float InTarget)
 	{
-		Previous->TweenInstance->ToRotation(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToRotation(InTarget);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromRotation(UBUIParamChain* Previous, const float InStart)
 	{
-		Previous->TweenInstance->FromRotation(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromRotation(InStart);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToMaxDesiredHeight(UBUIParamChain* Previous, const float InTarget)
 	{
-		Previous->TweenInstance->ToMaxDesiredHeight(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToMaxDesiredHeight(InTarget);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromMaxDesiredHeight(UBUIParamChain* Previous, const float InStart)
 	{
-		Previous->TweenInstance->FromMaxDesiredHeight(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromMaxDesiredHeight(InStart);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToCanvasPosition(UBUIParamChain* Previous, const FVector2D& InTarget)
 	{
-		Previous->TweenInstance->ToCanvasPosition(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToCanvasPosition(InTarget);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromCanvasPosition(UBUIParamChain* Previous, const FVector2D& InStart)
 	{
-		Previous->TweenInstance->FromCanvasPosition(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromCanvasPosition(InStart);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToPadding(UBUIParamChain* Previous, const FMargin& InTarget)
 	{
-		Previous->TweenInstance->ToPadding(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToPadding(InTarget);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromPadding(UBUIParamChain* Previous, const FMargin& InStart)
 	{
-		Previous->TweenInstance->FromPadding(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromPadding(InStart);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToVisibility(UBUIParamChain* Previous, const ESlateVisibility InTarget)
 	{
-		Previous->TweenInstance->ToVisibility(InTarget);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToVisibility(InTarget);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* FromVisibility(UBUIParamChain* Previous, const ESlateVisibility InStart)
 	{
-		Previous->TweenInstance->FromVisibility(InStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromVisibility(InStart);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* OpacityCurve(UBUIParamChain* Previous, const UCurveFloat* InCurve)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->OpacityCurve(InCurve);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* RotationCurve(UBUIParamChain* Previous, const UCurveFloat* InCurve)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->RotationCurve(InCurve);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* MaxDesiredHeightCurve(UBUIParamChain* Previous, const UCurveFloat* InCurve)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->MaxDesiredHeightCurve(InCurve);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* ToScalarParameter(UBUIParamChain* Previous, const FName InName, const float InTarget)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToScalarParameter(InName, InTarget);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* FromScalarParameter(UBUIParamChain* Previous, const FName InName, const float InStart)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromScalarParameter(InName, InStart);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* ToVectorParameter(UBUIParamChain* Previous, const FName InName, const FLinearColor& InTarget)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToVectorParameter(InName, InTarget);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* FromVectorParameter(UBUIParamChain* Previous, const FName InName, const FLinearColor& InStart)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromVectorParameter(InName, InStart);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* ToFloatProperty(UBUIParamChain* Previous, const FName InPath, const float InTarget)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToProperty(InPath, InTarget);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* FromFloatProperty(UBUIParamChain* Previous, const FName InPath, const float InStart)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromProperty(InPath, InStart);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* ToVector2DProperty(UBUIParamChain* Previous, const FName InPath, const FVector2D& InTarget)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToProperty(InPath, InTarget);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* FromVector2DProperty(UBUIParamChain* Previous, const FName InPath, const FVector2D& InStart)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromProperty(InPath, InStart);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* ToColorProperty(UBUIParamChain* Previous, const FName InPath, const FLinearColor& InTarget)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToProperty(InPath, InTarget);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* FromColorProperty(UBUIParamChain* Previous, const FName InPath, const FLinearColor& InStart)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromProperty(InPath, InStart);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* ToMarginProperty(UBUIParamChain* Previous, const FName InPath, const FMargin& InTarget)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToProperty(InPath, InTarget);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* FromMarginProperty(UBUIParamChain* Previous, const FName InPath, const FMargin& InStart)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->FromProperty(InPath, InStart);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* OnStart(UBUIParamChain* Previous, const FBUITweenBPSignature& InOnStart)
 	{
-		Previous->TweenInstance->OnStart(InOnStart);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->OnStart(InOnStart);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* Loop(UBUIParamChain* Previous, const int32 InNumCycles = -1, const EBUITweenLoopType InType = EBUITweenLoopType::Restart, const float InRepeatDelay = 0.0f)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->Loop(InNumCycles, InType, InRepeatDelay);
+		}
+		return Previous;
+	}
+
+	UFUNCTION(BlueprintPure, Category = UITween)
+	static UBUIParamChain* OnLoop(UBUIParamChain* Previous, const FBUITweenBPSignature& InOnLoop)
+	{
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->OnLoop(InOnLoop);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* OnComplete(UBUIParamChain* Previous, const FBUITweenBPSignature& InOnComplete)
 	{
-		Previous->TweenInstance->OnComplete(InOnComplete);
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->OnComplete(InOnComplete);
+		}
 		return Previous;
 	}
 
 	UFUNCTION(BlueprintPure, Category = UITween)
 	static UBUIParamChain* ToReset(UBUIParamChain* Previous)
 	{
-		Previous->TweenInstance->ToReset();
+		if (FBUITweenInstance* Tween = Previous->GetInstance())
+		{
+			Tween->ToReset();
+		}
 		return Previous;
 	}
 
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/IsInvocable.h"
+
+class UWidget;
+
+// A start/complete callback stored inline in the tween, so binding a small lambda doesn't allocate
+// the way a delegate does. Anything bigger than InlineSize won't compile, use a FBUITweenSignature for those.
+class FBUITweenCallback
+{
+public:
+	// Enough for a this pointer and a few captured values
+	static constexpr int32 InlineSize = 32;
+
+	FBUITweenCallback() { }
+	~FBUITweenCallback()
+	{
+		Reset();
+	}
+
+	FBUITweenCallback( const FBUITweenCallback& Other )
+	{
+		CopyFrom( Other );
+	}
+	FBUITweenCallback( FBUITweenCallback&& Other )
+	{
+		MoveFrom( Other );
+	}
+	FBUITweenCallback& operator=( const FBUITweenCallback& Other )
+	{
+		if ( this != &Other )
+		{
+			Reset();
+			CopyFrom( Other );
+		}
+		return *this;
+	}
+	FBUITweenCallback& operator=( FBUITweenCallback&& Other )
+	{
+		if ( this != &Other )
+		{
+			Reset();
+			MoveFrom( Other );
+		}
+		return *this;
+	}
+
+	template<typename FunctorType>
+	void Bind( FunctorType&& Functor )
+	{
+		typedef typename TDecay<FunctorType>::Type FDecayedType;
+		static_assert( TIsInvocable<FDecayedType, UWidget*>::Value, "Callbacks take the tween's UWidget*" );
+		static_assert( sizeof( FDecayedType ) <= InlineSize, "Callback captures too much to store inline, bind a FBUITweenSignature instead" );
+		static_assert( alignof( FDecayedType ) <= 16, "Callback is over-aligned for the inline storage" );
+
+		Reset();
+		new ( &Storage ) FDecayedType( Forward<FunctorType>( Functor ) );
+		Ops = &TOps<FDecayedType>::Ops;
+	}
+
+	bool IsBound() const { return Ops != nullptr; }
+
+	void ExecuteIfBound( UWidget* pWidget ) const
+	{
+		if ( Ops )
+		{
+			Ops->Invoke( const_cast<void*>( static_cast<const void*>( &Storage ) ), pWidget );
+		}
+	}
+
+	void Reset()
+	{
+		if ( Ops )
+		{
+			Ops->Destroy( &Storage );
+			Ops = nullptr;
+		}
+	}
+
+private:
+	struct FOps
+	{
+		void ( *Invoke )( void* Functor, UWidget* pWidget );
+		void ( *Copy )( const void* Functor, void* Dest );
+		void ( *Move )( void* Functor, void* Dest );
+		void ( *Destroy )( void* Functor );
+	};
+
+	template<typename T>
+	struct TOps
+	{
+		static void Invoke( void* Functor, UWidget* pWidget ) { ( *static_cast<T*>( Functor ) )( pWidget ); }
+		static void Copy( const void* Functor, void* Dest ) { new ( Dest ) T( *static_cast<const T*>( Functor ) ); }
+		static void Move( void* Functor, void* Dest ) { new ( Dest ) T( MoveTemp( *static_cast<T*>( Functor ) ) ); }
+		static void Destroy( void* Functor ) { static_cast<T*>( Functor )->~T(); }
+
+		static constexpr FOps Ops = { &Invoke, &Copy, &Move, &Destroy };
+	};
+
+	void CopyFrom( const FBUITweenCallback& Other )
+	{
+		if ( Other.Ops )
+		{
+			Other.Ops->Copy( &Other.Storage, &Storage );
+			Ops = Other.Ops;
+		}
+	}
+	void MoveFrom( FBUITweenCallback& Other )
+	{
+		if ( Other.Ops )
+		{
+			Other.Ops->Move( &Other.Storage, &Storage );
+			Ops = Other.Ops;
+			Other.Reset();
+		}
+	}
+
+	TAlignedBytes< InlineSize, 16 > Storage;
+	const FOps* Ops = nullptr;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUITweenGroup.generated.h"
+
+// When in the world's frame a tween group updates
+UENUM()
+enum class EBUITweenTickPhase : uint8
+{
+	// Before actors tick, so gameplay code sees this frame's values
+	PreActorTick,
+	// After actors tick, so tweens started by gameplay this frame begin straight away
+	PostActorTick,
+	// With the other tickable objects at the end of the world tick
+	EndOfFrame,
+};
+
+// How a named group of tweens advances. Each group has its own storage, so pausing one skips all of
+// its tweens at once rather than flagging them one by one.
+USTRUCT()
+struct BUITWEEN_API FBUITweenGroupSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category="Group", meta=(ClampMin="0"))
+	float TimeScale = 1;
+
+	// Scale time by the world's time dilation, like gameplay does. Off for menus that ignore slomo
+	UPROPERTY(EditAnywhere, Category="Group")
+	bool bUseTimeDilation = false;
+
+	// Stop while the game is paused. Off for the pause menu itself
+	UPROPERTY(EditAnywhere, Category="Group")
+	bool bPauseWithGame = false;
+
+	UPROPERTY(EditAnywhere, Category="Group")
+	EBUITweenTickPhase TickPhase = EBUITweenTickPhase::EndOfFrame;
+
+	// Hold the group's callbacks until the end of the frame, rather than firing them straight after its
+	// update. Keeps gameplay reacting to finished tweens out of an earlier tick phase
+	UPROPERTY(EditAnywhere, Category="Group")
+	bool bDeferCallbacks = false;
+};
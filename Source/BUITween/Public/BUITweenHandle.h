@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUITweenHandle.generated.h"
+
+// Refers to one tween for its whole lifetime. Once the tween completes or is cancelled its slot is
+// recycled with a new generation, so stale handles simply stop resolving. StorageId says which world's
+// tweens it belongs to, see UBUITweenSubsystem.
+USTRUCT(BlueprintType)
+struct BUITWEEN_API FBUITweenHandle
+{
+	GENERATED_BODY()
+
+public:
+	FBUITweenHandle() { }
+	FBUITweenHandle( int32 InIndex, uint32 InGeneration, uint32 InStorageId )
+		: Index( InIndex )
+		, Generation( InGeneration )
+		, StorageId( InStorageId )
+	{
+	}
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Invalidate() { *this = FBUITweenHandle(); }
+
+	inline bool operator==( const FBUITweenHandle& Other ) const
+	{
+		return Index == Other.Index && Generation == Other.Generation && StorageId == Other.StorageId;
+	}
+	inline bool operator!=( const FBUITweenHandle& Other ) const
+	{
+		return !( *this == Other );
+	}
+
+	friend uint32 GetTypeHash( const FBUITweenHandle& Handle )
+	{
+		return HashCombine( HashCombine( ::GetTypeHash( Handle.Index ), ::GetTypeHash( Handle.Generation ) ), ::GetTypeHash( Handle.StorageId ) );
+	}
+
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+	uint32 StorageId = 0;
+};
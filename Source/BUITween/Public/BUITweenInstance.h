@@ -2,24 +2,54 @@
 
 #include "BUIEasing.h"
 #include "Components/Widget.h"
+#include "BUITweenHandle.h"
+#include "BUITweenTargets.h"
+#include "BUITweenCallback.h"
+#include "BUITweenSpring.h"
+#include "BUITweenProperty.h"
+#include "BUITweenKeys.h"
 #include "BUITweenInstance.generated.h"
 
 DECLARE_DELEGATE_OneParam( FBUITweenSignature, UWidget* /*Owner*/ );
 DECLARE_DYNAMIC_DELEGATE_OneParam( FBUITweenBPSignature, UWidget*, Owner );
 
+class FBUITweenStagger;
+struct FBUITweenWidgetWrite;
+class UMaterialInstanceDynamic;
+class UCurveFloat;
+
 BUITWEEN_API DECLARE_LOG_CATEGORY_EXTERN(LogBUITween, Log, All);
 
+UENUM( BlueprintType )
+enum class EBUITweenLoopType : uint8
+{
+	// Every cycle plays from the start again
+	Restart,
+	// Every other cycle plays backwards, so the tween goes there and back
+	PingPong,
+};
+
+enum class EBUITweenEvent : uint8
+{
+	Start,
+	Loop,
+	Complete,
+};
+
 template<typename T>
 class TBUITweenProp
 {
 public:
 	bool bHasStart = false;
 	bool bHasTarget = false;
-	inline bool IsSet() const { return bHasStart || bHasTarget; }
+	inline bool IsSet() const { return bHasStart || bHasTarget || Keys.Num() > 0; }
 	T StartValue;
 	T TargetValue;
 	T CurrentValue;
 	bool bIsFirstTime = true;
+	// When there are keys they replace the lerp to TargetValue, which becomes the last key's value
+	TBUITweenKeys<T> Keys;
+	int32 KeyCursor = 0;
 	void SetStart( T InStart )
 	{
 		bHasStart = true;
@@ -38,11 +68,21 @@ public:
 			StartValue = InCurrentValue;
 			CurrentValue = InCurrentValue;
 		}
+		// A prop with only a From value holds still rather than lerping to garbage
+		if ( !bHasTarget )
+		{
+			TargetValue = StartValue;
+		}
+		if ( Keys.Num() > 0 )
+		{
+			TargetValue = Keys.GetLastValue();
+		}
+		KeyCursor = 0;
 	}
 	bool Update( float Alpha )
 	{
 		const T OldValue = CurrentValue;
-		CurrentValue = FMath::Lerp<T>( StartValue, TargetValue, Alpha );
+		CurrentValue = Keys.Num() > 0 ? Keys.Evaluate( StartValue, Alpha, KeyCursor ) : FMath::Lerp<T>( StartValue, TargetValue, Alpha );
 		const bool bShouldUpdate = bIsFirstTime || CurrentValue != OldValue;
 		bIsFirstTime = false;
 		return bShouldUpdate;
@@ -96,6 +136,25 @@ public:
 	}
 };
 
+// A named parameter on the widget's dynamic material. Scalars only use R, so both kinds share one channel
+class FBUITweenMaterialParamProp : public TBUITweenProp<FLinearColor>
+{
+public:
+	FName Name;
+	bool bIsVector = false;
+	// Resolved at Begin(), where the parameter sits in the material's overrides so writes skip the name lookup
+	int32 ParameterIndex = INDEX_NONE;
+};
+
+// Any float, FVector2D, FLinearColor or FMargin property or setter on the widget, see FBUITweenPropertyBinding
+class FBUITweenPropertyProp : public TBUITweenProp<FVector4>
+{
+public:
+	FName Path;
+	// Resolved at Begin() from the class's binding table
+	FBUITweenPropertyBinding Binding;
+};
+
 
 USTRUCT()
 struct BUITWEEN_API FBUITweenInstance
@@ -112,21 +171,30 @@ public:
 		ensure( pInWidget != nullptr );
 
 	}
+	// A tween on a plain Slate widget, which only drives translation, scale, rotation and opacity
+	FBUITweenInstance( const TSharedRef<SWidget>& InSlateWidget, float InDuration, float InDelay = 0 )
+		: SlateWidget( InSlateWidget )
+		, Duration( InDuration )
+		, Delay( InDelay )
+	{
+	}
+	// Captures the start values and queues the tween. Only valid until its first update, restarting a
+	// tween means creating a new one.
 	void Begin();
-	void Update( float InDeltaTime );
-	void Apply( float EasedAlpha );
+	// With a widget write the render transform, color and opacity are left in it for the storage to write
+	void Apply( float EasedAlpha, FBUITweenWidgetWrite* pWrite = nullptr );
 
 	inline bool operator==( const FBUITweenInstance& other) const
 	{
 		return pWidget == other.pWidget;
 	}
-	bool IsComplete() const { return bIsComplete; }
 
 	// EasingParam is used for easing functions that have a second parameter, like Elastic
 	FBUITweenInstance& Easing( EBUIEasingType InType, TOptional<float> InEasingParam = TOptional<float>() )
 	{
 		EasingType = InType;
 		EasingParam = InEasingParam;
+		bHasEasing = true;
 		return *this;
 	}
 
@@ -240,16 +308,153 @@ public:
 		return *this;
 	}
 
+	// Keyframes, each at a fraction of the duration and eased in from the key before it. The first segment
+	// starts from the From value or the widget's current one. A prop's keys replace its To value, and the
+	// tween's own easing then stretches the whole timeline, so it defaults to Linear once keys are added.
+	// Springs ignore the keys and go to the last one.
+	FBUITweenInstance& TranslationKey( float InTime, const FVector2D& InValue, EBUIEasingType InEasing = EBUIEasingType::Linear, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		return AddKey( TranslationProp, InTime, InValue, InEasing, InEasingParam );
+	}
+	FBUITweenInstance& ScaleKey( float InTime, const FVector2D& InValue, EBUIEasingType InEasing = EBUIEasingType::Linear, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		return AddKey( ScaleProp, InTime, InValue, InEasing, InEasingParam );
+	}
+	FBUITweenInstance& RotationKey( float InTime, float InValue, EBUIEasingType InEasing = EBUIEasingType::Linear, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		return AddKey( RotationProp, InTime, InValue, InEasing, InEasingParam );
+	}
+	FBUITweenInstance& OpacityKey( float InTime, float InValue, EBUIEasingType InEasing = EBUIEasingType::Linear, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		return AddKey( OpacityProp, InTime, InValue, InEasing, InEasingParam );
+	}
+	FBUITweenInstance& ColorKey( float InTime, const FLinearColor& InValue, EBUIEasingType InEasing = EBUIEasingType::Linear, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		return AddKey( ColorProp, InTime, InValue, InEasing, InEasingParam );
+	}
+	FBUITweenInstance& CanvasPositionKey( float InTime, const FVector2D& InValue, EBUIEasingType InEasing = EBUIEasingType::Linear, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		return AddKey( CanvasPositionProp, InTime, InValue, InEasing, InEasingParam );
+	}
+	FBUITweenInstance& PaddingKey( float InTime, const FMargin& InValue, EBUIEasingType InEasing = EBUIEasingType::Linear, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		return AddKey( PaddingProp, InTime, FVector4( InValue.Left, InValue.Top, InValue.Right, InValue.Bottom ), InEasing, InEasingParam );
+	}
+	FBUITweenInstance& MaxDesiredHeightKey( float InTime, float InValue, EBUIEasingType InEasing = EBUIEasingType::Linear, TOptional<float> InEasingParam = TOptional<float>() )
+	{
+		return AddKey( MaxDesiredHeightProp, InTime, InValue, InEasing, InEasingParam );
+	}
+
+	// A float curve baked into keys, its time range stretched over the tween's duration. Replaces any keys
+	// the prop had.
+	FBUITweenInstance& RotationCurve( const FRichCurve& InCurve );
+	FBUITweenInstance& RotationCurve( const UCurveFloat* pInCurve );
+	FBUITweenInstance& OpacityCurve( const FRichCurve& InCurve );
+	FBUITweenInstance& OpacityCurve( const UCurveFloat* pInCurve );
+	FBUITweenInstance& MaxDesiredHeightCurve( const FRichCurve& InCurve );
+	FBUITweenInstance& MaxDesiredHeightCurve( const UCurveFloat* pInCurve );
+
+	// Named parameters on a UImage or UBorder's dynamic material, which is made from its brush material if
+	// it isn't one already. Each name is its own prop. Not played by staggered groups.
+	FBUITweenInstance& ToScalarParameter( FName InName, float InTarget )
+	{
+		FindOrAddMaterialParam( InName, false ).SetTarget( FLinearColor( InTarget, 0, 0, 0 ) );
+		return *this;
+	}
+	FBUITweenInstance& FromScalarParameter( FName InName, float InStart )
+	{
+		FindOrAddMaterialParam( InName, false ).SetStart( FLinearColor( InStart, 0, 0, 0 ) );
+		return *this;
+	}
+	FBUITweenInstance& ToVectorParameter( FName InName, const FLinearColor& InTarget )
+	{
+		FindOrAddMaterialParam( InName, true ).SetTarget( InTarget );
+		return *this;
+	}
+	FBUITweenInstance& FromVectorParameter( FName InName, const FLinearColor& InStart )
+	{
+		FindOrAddMaterialParam( InName, true ).SetStart( InStart );
+		return *this;
+	}
+
+	// Any property or setter on the widget by name, with dots to reach into structs. The lookup happens once
+	// per widget class, after that a write is a store into the widget or a call to the setter. Not played by
+	// staggered groups.
+	FBUITweenInstance& ToProperty( FName InPath, float InTarget )
+	{
+		FindOrAddProperty( InPath ).SetTarget( FVector4( InTarget, 0, 0, 0 ) );
+		return *this;
+	}
+	FBUITweenInstance& ToProperty( FName InPath, const FVector2D& InTarget )
+	{
+		FindOrAddProperty( InPath ).SetTarget( FVector4( InTarget.X, InTarget.Y, 0, 0 ) );
+		return *this;
+	}
+	FBUITweenInstance& ToProperty( FName InPath, const FLinearColor& InTarget )
+	{
+		FindOrAddProperty( InPath ).SetTarget( FVector4( InTarget.R, InTarget.G, InTarget.B, InTarget.A ) );
+		return *this;
+	}
+	FBUITweenInstance& ToProperty( FName InPath, const FMargin& InTarget )
+	{
+		FindOrAddProperty( InPath ).SetTarget( FVector4( InTarget.Left, InTarget.Top, InTarget.Right, InTarget.Bottom ) );
+		return *this;
+	}
+	FBUITweenInstance& FromProperty( FName InPath, float InStart )
+	{
+		FindOrAddProperty( InPath ).SetStart( FVector4( InStart, 0, 0, 0 ) );
+		return *this;
+	}
+	FBUITweenInstance& FromProperty( FName InPath, const FVector2D& InStart )
+	{
+		FindOrAddProperty( InPath ).SetStart( FVector4( InStart.X, InStart.Y, 0, 0 ) );
+		return *this;
+	}
+	FBUITweenInstance& FromProperty( FName InPath, const FLinearColor& InStart )
+	{
+		FindOrAddProperty( InPath ).SetStart( FVector4( InStart.R, InStart.G, InStart.B, InStart.A ) );
+		return *this;
+	}
+	FBUITweenInstance& FromProperty( FName InPath, const FMargin& InStart )
+	{
+		FindOrAddProperty( InPath ).SetStart( FVector4( InStart.Left, InStart.Top, InStart.Right, InStart.Bottom ) );
+		return *this;
+	}
+
 	FBUITweenInstance& OnStart( const FBUITweenSignature& InOnStart )
 	{
 		OnStartedDelegate = InOnStart;
 		return *this;
 	}
+	FBUITweenInstance& OnStart( FBUITweenSignature&& InOnStart )
+	{
+		OnStartedDelegate = MoveTemp( InOnStart );
+		return *this;
+	}
 	FBUITweenInstance& OnComplete( const FBUITweenSignature& InOnComplete )
 	{
 		OnCompleteDelegate = InOnComplete;
 		return *this;
 	}
+	FBUITweenInstance& OnComplete( FBUITweenSignature&& InOnComplete )
+	{
+		OnCompleteDelegate = MoveTemp( InOnComplete );
+		return *this;
+	}
+
+	// Takes a lambda directly, stored inside the tween so it doesn't allocate. See FBUITweenCallback
+	template<typename FunctorType, typename = typename TEnableIf<TIsInvocable<typename TDecay<FunctorType>::Type, UWidget*>::Value>::Type>
+	FBUITweenInstance& OnStart( FunctorType&& InOnStart )
+	{
+		OnStartedCallback.Bind( Forward<FunctorType>( InOnStart ) );
+		return *this;
+	}
+	template<typename FunctorType, typename = typename TEnableIf<TIsInvocable<typename TDecay<FunctorType>::Type, UWidget*>::Value>::Type>
+	FBUITweenInstance& OnComplete( FunctorType&& InOnComplete )
+	{
+		OnCompleteCallback.Bind( Forward<FunctorType>( InOnComplete ) );
+		return *this;
+	}
 
 	FBUITweenInstance& OnStart( const FBUITweenBPSignature& InOnStart )
 	{
@@ -262,6 +467,68 @@ public:
 		return *this;
 	}
 
+	// Drive every prop with a spring rather than the duration and easing. The tween completes once every
+	// prop has settled on its target, UBUITween::Retarget moves the targets while it runs.
+	FBUITweenInstance& Spring( float InStiffness = 170, float InDamping = 26, float InMass = 1 )
+	{
+		SpringParams = FBUITweenSpring( InStiffness, InDamping, InMass );
+		return *this;
+	}
+	// A settled spring goes to sleep instead of completing, and wakes when it's retargeted. It then runs
+	// until cancelled or cleared, which suits something that keeps following the cursor.
+	FBUITweenInstance& KeepAliveWhenSettled( bool bInKeepAlive = true )
+	{
+		bKeepAliveWhenSettled = bInKeepAlive;
+		return *this;
+	}
+	// Starting velocity of a translation spring in units per second, to carry on from a drag release
+	FBUITweenInstance& FromTranslationVelocity( const FVector2D& InVelocity )
+	{
+		TranslationVelocity = InVelocity;
+		return *this;
+	}
+
+	// Plays the tween InNumCycles times in total, or forever if it's negative, by wrapping its time rather
+	// than recreating it. A repeat delay holds each cycle's end before the next one. OnComplete only fires
+	// after the last cycle, OnLoop after each of the others. Not for springs, staggered groups or sequences.
+	FBUITweenInstance& Loop( int32 InNumCycles = INDEX_NONE, EBUITweenLoopType InType = EBUITweenLoopType::Restart, float InRepeatDelay = 0 )
+	{
+		NumCycles = InNumCycles;
+		LoopType = InType;
+		RepeatDelay = FMath::Max( InRepeatDelay, 0.0f );
+		return *this;
+	}
+	FBUITweenInstance& OnLoop( const FBUITweenSignature& InOnLoop )
+	{
+		OnLoopDelegate = InOnLoop;
+		return *this;
+	}
+	FBUITweenInstance& OnLoop( FBUITweenSignature&& InOnLoop )
+	{
+		OnLoopDelegate = MoveTemp( InOnLoop );
+		return *this;
+	}
+	template<typename FunctorType, typename = typename TEnableIf<TIsInvocable<typename TDecay<FunctorType>::Type, UWidget*>::Value>::Type>
+	FBUITweenInstance& OnLoop( FunctorType&& InOnLoop )
+	{
+		OnLoopCallback.Bind( Forward<FunctorType>( InOnLoop ) );
+		return *this;
+	}
+	FBUITweenInstance& OnLoop( const FBUITweenBPSignature& InOnLoop )
+	{
+		OnLoopBPDelegate = InOnLoop;
+		return *this;
+	}
+
+	// Skip the widget writes while the widget, one of its parents or its ScrollBox viewport hides it. Time
+	// still advances and the tween snaps to where it should be once the widget shows again.
+	// Defaults to the BUITween.CullHidden console variable.
+	FBUITweenInstance& CullWhenHidden( bool bInCull = true )
+	{
+		bShouldCull = bInCull;
+		return *this;
+	}
+
 	FBUITweenInstance& ToReset()
 	{
 		ScaleProp.SetTarget( FVector2D::UnitVector );
@@ -273,28 +540,77 @@ public:
 	}
 
 	TWeakObjectPtr<UWidget> GetWidget() const { return pWidget; }
+	TWeakPtr<SWidget> GetSlateWidget() const { return SlateWidget; }
+	FBUITweenHandle GetHandle() const { return Handle; }
 
-	void DoCompleteCleanup()
-	{
-		if ( !bHasPlayedCompleteEvent )
+	// How far past its duration the tween got on the frame it completed. Read it in OnComplete and pass it
+	// as a negative delay to chain a tween without losing time.
+	float GetCompletionOverflow() const { return CompletionOverflow; }
+
+	void DoStartEvent();
+	void DoCompleteCleanup();
+
+	// The two halves of an event, so the storage can fire every native callback of a frame before the
+	// Blueprint ones. Returns false when the start or complete event has already played.
+	bool DoNativeEvent( EBUITweenEvent Type );
+	void DoBlueprintEvent( EBUITweenEvent Type );
+
+protected:
+	friend class FBUITweenStorage;
+	friend class FBUITweenSequence;
+	friend class FBUITweenStagger;
+struct FBUITweenWidgetWrite;
+	friend class FBUITweenRetarget;
+
+	// Reads the widget's current value for every prop without a From value. Targets must be resolved
+	void CaptureStartValues();
+	void CaptureSlateStartValues( SWidget& InSlateWidget );
+	void ApplySlate( SWidget& InSlateWidget, float EasedAlpha );
+	FBUITweenMaterialParamProp& FindOrAddMaterialParam( FName InName, bool bInIsVector );
+	FBUITweenPropertyProp& FindOrAddProperty( FName InPath );
+
+	template<typename T>
+	FBUITweenInstance& AddKey( TBUITweenProp<T>& Prop, float InTime, const T& InValue, EBUIEasingType InEasing, TOptional<float> InEasingParam )
+	{
+		Prop.Keys.Add( InTime, InValue, InEasing, InEasingParam.Get( FBUIEasing::DefaultParam ) );
+		if ( !bHasEasing )
 		{
-			OnCompleteDelegate.ExecuteIfBound( pWidget.Get() );
-			OnCompleteBPDelegate.ExecuteIfBound( pWidget.Get() );
-			bHasPlayedCompleteEvent = true;
+			EasingType = EBUIEasingType::Linear;
 		}
+		return *this;
 	}
+	FBUITweenInstance& BakeCurve( TBUITweenProp<float>& Prop, const FRichCurve& InCurve );
+	FBUITweenInstance& BakeCurve( TBUITweenProp<float>& Prop, const UCurveFloat* pInCurve );
 
-protected:
+	FBUITweenHandle Handle;
 	bool bShouldUpdate = false;
-	bool bIsComplete = false;
+	bool bIsPaused = false;
 
 	TWeakObjectPtr<UWidget> pWidget = nullptr;
-	float Alpha = 0;
+	// Set instead of pWidget for tweens made by UBUITween::CreateSlate
+	TWeakPtr<SWidget> SlateWidget;
 	float Duration = 1;
 	float Delay = 0;
+	float CompletionOverflow = 0;
 
 	EBUIEasingType EasingType = EBUIEasingType::InOutQuad;
 	TOptional<float> EasingParam;
+	// Set by Easing(), otherwise adding keys switches the easing to Linear
+	bool bHasEasing = false;
+	TOptional<bool> bShouldCull;
+
+	int32 NumCycles = 1;
+	EBUITweenLoopType LoopType = EBUITweenLoopType::Restart;
+	float RepeatDelay = 0;
+
+	TOptional<FBUITweenSpring> SpringParams;
+	TOptional<FVector2D> TranslationVelocity;
+	bool bKeepAliveWhenSettled = false;
+
+	FBUITweenTargets Targets;
+
+	// Set when this instance is the shared configuration of a staggered group rather than a tween on pWidget
+	FBUITweenStagger* pStagger = nullptr;
 
 	TBUITweenProp<FVector2D> TranslationProp;
 	TBUITweenProp<FVector2D> ScaleProp;
@@ -306,11 +622,23 @@ protected:
 	TBUITweenInstantProp<ESlateVisibility> VisibilityProp;
 	TBUITweenProp<float> MaxDesiredHeightProp;
 
+	TArray< FBUITweenMaterialParamProp > MaterialParams;
+	// Resolved at Begin() when there are material params
+	TWeakObjectPtr<UMaterialInstanceDynamic> pMaterial;
+
+	TArray< FBUITweenPropertyProp > Properties;
+
 	FBUITweenSignature OnStartedDelegate;
 	FBUITweenSignature OnCompleteDelegate;
+	FBUITweenSignature OnLoopDelegate;
+
+	FBUITweenCallback OnStartedCallback;
+	FBUITweenCallback OnCompleteCallback;
+	FBUITweenCallback OnLoopCallback;
 
 	FBUITweenBPSignature OnStartedBPDelegate;
 	FBUITweenBPSignature OnCompleteBPDelegate;
+	FBUITweenBPSignature OnLoopBPDelegate;
 
 	bool bHasPlayedStartEvent = false;
 	bool bHasPlayedCompleteEvent = false;
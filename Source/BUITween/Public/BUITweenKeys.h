@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+
+struct FRichCurve;
+
+template<typename T>
+struct TBUITweenKey
+{
+	// Fraction of the tween, 0 to 1 on its eased alpha
+	float Time;
+	T Value;
+	// Easing of the segment arriving at this key
+	EBUIEasingType EasingType;
+	float EasingParam;
+};
+
+// Keyframes of one prop, sorted by time in one packed array. Before the first key the prop eases from its
+// start value, the From value or the widget's own, and after the last key it holds there.
+// The keys don't change once the tween has begun, so evaluating only needs a cursor on the key the current
+// segment leads to. Time mostly moves forward a little each frame, so it steps at most once or twice
+// whatever the number of keys.
+template<typename T>
+class TBUITweenKeys
+{
+public:
+	void Add( float InTime, const T& InValue, EBUIEasingType InEasingType, float InEasingParam )
+	{
+		// Keys are usually added in order, which makes this an append
+		const float Time = FMath::Clamp( InTime, 0.0f, 1.0f );
+		int32 Index = Keys.Num();
+		while ( Index > 0 && Keys[ Index - 1 ].Time > Time )
+		{
+			--Index;
+		}
+		Keys.Insert( TBUITweenKey<T>{ Time, InValue, InEasingType, InEasingParam }, Index );
+	}
+	void Reset()
+	{
+		Keys.Reset();
+	}
+
+	int32 Num() const { return Keys.Num(); }
+	const T& GetLastValue() const { return Keys.Last().Value; }
+
+	// InOutNext is the caller's cursor, the index of the key the last evaluated segment led to
+	T Evaluate( const T& InStartValue, float Alpha, int32& InOutNext ) const
+	{
+		check( Keys.Num() > 0 );
+
+		int32 Next = FMath::Clamp( InOutNext, 0, Keys.Num() );
+		while ( Next < Keys.Num() && Keys[ Next ].Time <= Alpha )
+		{
+			++Next;
+		}
+		while ( Next > 0 && Keys[ Next - 1 ].Time > Alpha )
+		{
+			--Next;
+		}
+		InOutNext = Next;
+
+		if ( Next == Keys.Num() )
+		{
+			return Keys.Last().Value;
+		}
+		const TBUITweenKey<T>& To = Keys[ Next ];
+		const float FromTime = Next > 0 ? Keys[ Next - 1 ].Time : 0.0f;
+		const float Length = To.Time - FromTime;
+		if ( Length <= 0 )
+		{
+			return To.Value;
+		}
+		const float Eased = FBUIEasing::Ease( To.EasingType, FMath::Max( Alpha - FromTime, 0.0f ), Length, To.EasingParam );
+		return FMath::Lerp( Next > 0 ? Keys[ Next - 1 ].Value : InStartValue, To.Value, Eased );
+	}
+
+protected:
+	TArray< TBUITweenKey<T> > Keys;
+};
+
+// Where a channel entry reads its keys from, null for entries that are a plain lerp
+template<typename T>
+struct TBUITweenKeyCursor
+{
+	const TBUITweenKeys<T>* pKeys = nullptr;
+	int32 Next = 0;
+};
+
+struct BUITWEEN_API FBUITweenCurve
+{
+	// Segments of a cubic curve are sampled this many times, linear and constant ones are copied as they are
+	static constexpr int32 SamplesPerSegment = 8;
+
+	// Replaces the keys with the curve, its time range stretched over the tween
+	static void Bake( const FRichCurve& InCurve, TBUITweenKeys<float>& OutKeys );
+};
@@ -27,9 +27,10 @@ public:
 	{
 		return true;
 	}
+	// Slate tweens can run in editor tools, which have no game world
 	virtual bool IsTickableInEditor() const
 	{
-		return false;
+		return true;
 	}
 
 
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+
+enum class EBUITweenPropertyType : uint8
+{
+	None,
+	Float,
+	Double,
+	Vector2D,
+	LinearColor,
+	Margin,
+};
+
+// Where a UPROPERTY or setter UFUNCTION lives on a widget class, resolved from its path once per class.
+// Values travel as FVector4 like the padding channel: X for floats, XY for FVector2D, RGBA for colors and
+// Left, Top, Right, Bottom for margins.
+struct BUITWEEN_API FBUITweenPropertyBinding
+{
+public:
+	// Looks the path up in the class's binding table, resolving it the first time. The path is either a
+	// property, with dots to reach into struct members, or the name of a setter taking one value. A property
+	// with a matching Set<Name> function, like UProgressBar's Percent, is written through the setter so the
+	// change reaches Slate.
+	static FBUITweenPropertyBinding Find( UClass* pClass, FName InPath );
+
+	bool IsValid() const { return Type != EBUITweenPropertyType::None; }
+	// Setter-only paths can't be read, they need a From value
+	bool IsReadable() const { return Offset != INDEX_NONE; }
+
+	bool Read( const UWidget* pWidget, FVector4& OutValue ) const;
+	// Calls the setter, or stores straight into the widget and synchronizes it with its Slate widget
+	void Write( UWidget* pWidget, const FVector4& InValue ) const;
+
+protected:
+	static FBUITweenPropertyBinding Resolve( UClass* pClass, FName InPath );
+
+	// Offset of the value from the start of the widget, through any structs on the way
+	int32 Offset = INDEX_NONE;
+	UFunction* pSetter = nullptr;
+	int32 SetterParamOffset = 0;
+	EBUITweenPropertyType Type = EBUITweenPropertyType::None;
+};
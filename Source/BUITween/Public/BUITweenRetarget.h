@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+#include "BUITweenHandle.h"
+
+class FBUITweenStorage;
+
+// Moves the targets of a tween that is already running, without recreating it or reading the widget
+// back. Only props the tween was created with can be retargeted.
+// A duration tween restarts from wherever it is on the first change, every prop then follows the
+// tween's easing from its current value to its target, over the same duration unless Duration() changes
+// it. A cubic Hermite term on top makes up the difference between the curve's starting speed and the
+// prop's current velocity, so the speed carries over whichever easing it ends up with.
+// A spring just pulls towards the new targets.
+//
+//	UBUITween::Retarget( Button ).ToScale( FVector2D( bIsHovered ? 1.1f : 1.0f ) ).Duration( 0.15f );
+class BUITWEEN_API FBUITweenRetarget
+{
+public:
+	FBUITweenRetarget() { }
+	FBUITweenRetarget( FBUITweenStorage* pInStorage, const FBUITweenHandle& InHandle )
+		: pStorage( pInStorage )
+		, Handle( InHandle )
+	{
+	}
+
+	// False once the tween has completed or been cancelled
+	bool IsValid() const;
+
+	FBUITweenRetarget& ToTranslation( const FVector2D& InTarget );
+	FBUITweenRetarget& ToTranslation( float X, float Y ) { return ToTranslation( FVector2D( X, Y ) ); }
+	FBUITweenRetarget& ToScale( const FVector2D& InTarget );
+	FBUITweenRetarget& ToRotation( float InTarget );
+	FBUITweenRetarget& ToOpacity( float InTarget );
+	FBUITweenRetarget& ToColor( const FLinearColor& InTarget );
+	FBUITweenRetarget& ToCanvasPosition( const FVector2D& InTarget );
+	FBUITweenRetarget& ToPadding( const FMargin& InTarget );
+	FBUITweenRetarget& ToMaxDesiredHeight( float InTarget );
+
+	FBUITweenRetarget& Duration( float InDuration );
+	FBUITweenRetarget& Easing( EBUIEasingType InType, TOptional<float> InEasingParam = TOptional<float>() );
+
+	// Whether every call so far found its prop on a live tween
+	bool Succeeded() const { return bSucceeded; }
+
+protected:
+	FBUITweenStorage* pStorage = nullptr;
+	FBUITweenHandle Handle;
+	bool bSucceeded = true;
+
+private:
+	// Rebases the tween once, before the first change made through this retarget
+	bool Rebase();
+
+	bool bIsRebased = false;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/IndirectArray.h"
+#include "BUITweenInstance.h"
+
+class FBUITweenStorage;
+
+// Many tweens across any number of widgets on one clock. The whole sequence is a single entry in the
+// tween update, each frame advances one cursor through its time-sorted start and end keyframes.
+//
+//	FBUITweenSequence& Intro = UBUITween::CreateSequence( 0.0f, this );
+//	Intro.Append( Title, 0.3f ).FromOpacity( 0 ).ToOpacity( 1 );
+//	Intro.Join( Title, 0.5f ).FromTranslation( 0, -50 ).ToTranslation( 0, 0 );
+//	Intro.Append( Button, 0.2f ).FromScale( FVector2D( 0.8f ) ).ToScale( FVector2D( 1 ) );
+//	Intro.Begin();
+//
+// The returned tweens only describe steps, their delay is ignored and they must not be begun themselves.
+class BUITWEEN_API FBUITweenSequence
+{
+public:
+	// Starts once everything added so far has finished
+	FBUITweenInstance& Append( UWidget* pInWidget, float InDuration );
+	// Starts at the same time as the last appended step
+	FBUITweenInstance& Join( UWidget* pInWidget, float InDuration );
+	// Starts at a fixed time from the start of the sequence
+	FBUITweenInstance& Insert( float InTime, UWidget* pInWidget, float InDuration );
+	// Adds empty time, the next Append starts after it
+	FBUITweenSequence& AppendInterval( float InInterval );
+
+	FBUITweenSequence& OnStart( const FBUITweenSignature& InOnStart );
+	FBUITweenSequence& OnComplete( const FBUITweenSignature& InOnComplete );
+
+	// Sorts the steps into keyframes and resolves their targets, the sequence starts on the next update.
+	// Like a tween's Begin it is only valid until then.
+	void Begin();
+
+	float GetDuration() const { return Duration; }
+	int32 NumSteps() const { return Steps.Num(); }
+	FBUITweenHandle GetHandle() const;
+
+protected:
+	friend class FBUITweenStorage;
+
+	struct FStep
+	{
+		FBUITweenInstance Instance;
+		float StartTime = 0;
+		bool bIsActive = false;
+		bool bIsDone = false;
+	};
+
+	struct FKeyframe
+	{
+		float Time;
+		int32 StepIndex;
+		bool bIsStart;
+	};
+
+	FBUITweenInstance& AddStep( float InStartTime, UWidget* pInWidget, float InDuration );
+
+	// Called by the storage's apply phase with the sequence's own clock. Step callbacks are queued on the
+	// storage with the rest of the frame's events.
+	void Advance( float Time, FBUITweenStorage& Storage );
+	void StartStep( int32 StepIndex, FBUITweenStorage& Storage );
+	// Only writes what changed, the transform, color and opacity through the storage's widget writes
+	void ApplyStep( FStep& Step, float Time, FBUITweenStorage& Storage );
+
+	// Steps are stored indirectly so the references handed out by Append stay valid
+	TIndirectArray< FStep > Steps;
+	TArray< FKeyframe > Keyframes;
+	// Steps between their start and end keyframes, in start order so overlapping steps apply consistently
+	TArray< int32 > ActiveSteps;
+	int32 Cursor = 0;
+
+	float Duration = 0;
+	float LastAppendTime = 0;
+
+	// The sequence's own slot tween, which carries its delay, pause state and callbacks
+	FBUITweenInstance* pOwner = nullptr;
+};
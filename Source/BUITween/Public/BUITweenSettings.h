@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "BUITweenGroup.h"
+#include "BUITweenSettings.generated.h"
+
+// Project Settings > Plugins > BUITween
+UCLASS(config=Game, defaultconfig, meta=(DisplayName="BUITween"))
+class BUITWEEN_API UBUITweenSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UBUITweenSettings()
+	{
+		CategoryName = TEXT( "Plugins" );
+	}
+
+	// Tweens preallocated at startup. Keep it above the most tweens you expect running at once, plus the
+	// ones created in the same frame, and tween creation and completion never allocate.
+	UPROPERTY(config, EditAnywhere, Category="Memory", meta=(ClampMin="0"))
+	int32 ReservedTweenCapacity = 128;
+
+	// Named tween groups every world starts with, see UBUITween::CreateInGroup. The None group holds every
+	// other tween and can be configured here too.
+	UPROPERTY(config, EditAnywhere, Category="Groups")
+	TMap<FName, FBUITweenGroupSettings> TweenGroups;
+
+	// Sample sine, expo, elastic and back easings from precomputed tables instead of calling Sin/Cos/Pow
+	// every frame. Meant for low-end targets where those calls dominate the tween update.
+	UPROPERTY(config, EditAnywhere, Category="Easing Lookup Tables")
+	bool bUseEasingLUT = false;
+
+	// Build the tables that don't depend on the tween when the module starts, rather than on first use
+	UPROPERTY(config, EditAnywhere, Category="Easing Lookup Tables", meta=(EditCondition="bUseEasingLUT"))
+	bool bBuildEasingLUTAtStartup = true;
+
+	// Starting number of intervals per table. Tables that miss EasingLUTMaxError double this until they fit
+	UPROPERTY(config, EditAnywhere, Category="Easing Lookup Tables", meta=(EditCondition="bUseEasingLUT", ClampMin="16", ClampMax="16384"))
+	int32 EasingLUTResolution = 256;
+
+	// Largest difference from the analytic curve a table may have, otherwise that easing stays analytic
+	UPROPERTY(config, EditAnywhere, Category="Easing Lookup Tables", meta=(EditCondition="bUseEasingLUT", ClampMin="0.000001"))
+	float EasingLUTMaxError = 0.001f;
+
+	// Elastic tables depend on the easing param and the duration, back tables on the param. Past this many
+	// combinations new ones are evaluated analytically, with a warning. Elastic durations that aren't a
+	// whole number of milliseconds never get a table.
+	UPROPERTY(config, EditAnywhere, Category="Easing Lookup Tables", meta=(EditCondition="bUseEasingLUT", ClampMin="0"))
+	int32 MaxKeyedEasingLUTs = 128;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Damped spring pulling a value to its target, solved in closed form rather than integrated, so it's
+// exact and stable for any time step, a hitch just lands further along the same curve.
+// The defaults are close to critically damped: fast, without overshoot.
+struct BUITWEEN_API FBUITweenSpring
+{
+	FBUITweenSpring() { }
+	FBUITweenSpring( float InStiffness, float InDamping, float InMass )
+		: Stiffness( InStiffness )
+		, Damping( InDamping )
+		, Mass( InMass )
+	{
+	}
+
+	float Stiffness = 170;
+	float Damping = 26;
+	float Mass = 1;
+
+	// The spring over one time step is linear in the distance to the target and the velocity, with the
+	// same coefficients for every component, so one step serves all the props of a tween:
+	//	Displacement' = YY * Displacement + YV * Velocity
+	//	Velocity' = VY * Displacement + VV * Velocity
+	struct FStep
+	{
+		float YY = 1;
+		float YV = 0;
+		float VY = 0;
+		float VV = 1;
+	};
+
+	FStep Step( float DeltaTime ) const;
+};
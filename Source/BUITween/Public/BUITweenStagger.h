@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "BUITweenInstance.h"
+
+class FBUITweenStorage;
+
+// One tween configuration played over a collection of widgets, each starting StaggerInterval after the
+// previous. The property targets and easing live once in the group's FBUITweenInstance, each element
+// only stores its widget, its start time and the start values read from it.
+// Elements are kept in start order, and since they share a duration they also finish in that order, so
+// each frame only touches the range of elements currently in flight.
+class BUITWEEN_API FBUITweenStagger
+{
+public:
+	// A negative interval staggers from the last widget to the first
+	void Init( TArrayView<UWidget* const> InWidgets, float InDuration, float InStaggerInterval );
+
+	float GetDuration() const;
+	int32 Num() const { return Elements.Num(); }
+
+	// Leaves the widget where it is for another tween to take over, the other elements carry on. Returns
+	// false when it had no element for the widget still playing.
+	bool StopElement( const FObjectKey& WidgetKey );
+
+protected:
+	friend class FBUITweenStorage;
+	friend struct FBUITweenInstance;
+
+	struct FElement
+	{
+		TWeakObjectPtr<UWidget> pWidget;
+		// Kept so the storage can still find the widget index entry once the widget is gone
+		FObjectKey WidgetKey;
+		FBUITweenTargets Targets;
+		float StartTime;
+		bool bIsStopped = false;
+	};
+
+	// Reads every element's start values and applies them, like a single tween's Begin()
+	void Begin( const FBUITweenInstance& Shared );
+	// Called by the storage's apply phase with the group's own clock
+	void Advance( const FBUITweenInstance& Shared, float Time, FBUITweenStorage& Storage );
+	// Only writes what differs from the widget. With a widget write the render transform, color and opacity
+	// are left in it for the storage to write.
+	void ApplyElement( const FBUITweenInstance& Shared, int32 Index, float EasedAlpha, FBUITweenWidgetWrite* pWrite = nullptr );
+
+	TArray< FElement > Elements;
+
+	// Start values per element, only filled for the props the shared tween sets
+	TArray< FVector2D > TranslationStarts;
+	TArray< FVector2D > ScaleStarts;
+	TArray< float > RotationStarts;
+	TArray< float > OpacityStarts;
+	TArray< FLinearColor > ColorStarts;
+	TArray< ESlateVisibility > VisibilityStarts;
+	TArray< FVector2D > CanvasPositionStarts;
+	TArray< FVector4 > PaddingStarts;
+	TArray< float > MaxDesiredHeightStarts;
+
+	float ElementDuration = 1;
+	float Interval = 0;
+
+	// Elements before FirstRunning have finished, elements from NumStarted on haven't started yet
+	int32 FirstRunning = 0;
+	int32 NumStarted = 0;
+};
@@ -0,0 +1,634 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BUIEasing.h"
+#include "BUIEasingLUT.h"
+#include "Containers/ChunkedArray.h"
+#include "UObject/ObjectKey.h"
+#include "Components/Widget.h"
+#include "Layout/ArrangedWidget.h"
+#include "BUITweenHandle.h"
+#include "BUITweenInstance.h"
+#include "BUITweenSequence.h"
+#include "BUITweenStagger.h"
+#include "BUITweenSpring.h"
+#include "BUITweenProperty.h"
+#include "BUITweenKeys.h"
+
+// Every property a tween can drive. Each one is stored in its own dense array in FBUITweenStorage
+enum class EBUITweenChannel : uint8
+{
+	Translation,
+	Scale,
+	Rotation,
+	Opacity,
+	Color,
+	Visibility,
+	CanvasPosition,
+	Padding,
+	MaxDesiredHeight,
+	// The channels a tween can have several entries in, see TBUITweenRunChannel
+	MaterialParameter,
+	Property,
+	Num
+};
+
+// A spring tween's state, kept beside the headers since few tweens use one
+struct FBUITweenSpringState
+{
+	// Header this spring belongs to
+	int32 Owner = INDEX_NONE;
+	FBUITweenSpring Spring;
+	// This frame's step of Spring, worked out once per header and shared by its channels
+	FBUITweenSpring::FStep Step;
+};
+
+// Compact per-tween data, the only thing the time update walks every frame
+struct FBUITweenHeader
+{
+	TWeakObjectPtr<UWidget> pWidget;
+
+	// Slot holding this tween's FBUITweenInstance
+	int32 SlotIndex = INDEX_NONE;
+
+	// Only valid during FBUITweenStorage's apply phase, resolved once from pWidget
+	UWidget* pResolvedWidget = nullptr;
+
+	float Alpha = 0;
+	float Duration = 1;
+	float Delay = 0;
+	// Time past Duration on the frame the tween completed
+	float Overflow = 0;
+	float EasedAlpha = 0;
+	float EasingParam = 0;
+	EBUIEasingType EasingType = EBUIEasingType::InOutQuad;
+	// Looked up when the tween gets its easing or duration, only valid while EasingTableGeneration matches
+	// FBUIEasingLUT::GetGeneration(). Null evaluates the easing analytically.
+	const FBUIEasingTable* pEasingTable = nullptr;
+	uint32 EasingTableGeneration = 0;
+
+	// Cycles to play after this one, negative loops forever. Only a duration tween loops
+	int32 LoopsLeft = 0;
+	// Held at the end of each cycle before the next, through Delay
+	float RepeatDelay = 0;
+
+	uint16 ChannelMask = 0;
+	uint8 NumMaterialParams = 0;
+	uint8 NumProperties = 0;
+
+	bool bHasEasingParam = false;
+	bool bShouldUpdate = false;
+	bool bHasStarted = false;
+	bool bStartedThisFrame = false;
+	bool bLoopedThisFrame = false;
+	bool bIsPingPong = false;
+	// Playing a ping-pong cycle backwards
+	bool bIsReversed = false;
+	bool bIsRunning = false;
+	bool bIsPaused = false;
+	bool bIsComplete = false;
+	bool bIsCancelled = false;
+	// Drives a FBUITweenSequence or FBUITweenStagger in the slot instead of channels, its Alpha is their clock
+	bool bIsGroup = false;
+	// Another active tween drives the same widget, so writes to it are coalesced during apply
+	bool bSharesWidget = false;
+	// Opted into culling, and the widget was found hidden this frame so nothing is applied
+	bool bCullWhenHidden = false;
+	bool bIsCulled = false;
+	// Drives the SWidget in its slot's instance rather than pWidget, only through the Slate channels
+	bool bIsSlate = false;
+	// Some of its entries follow keys rather than a lerp, see TBUITweenChannel::KeyCursors
+	bool bHasKeys = false;
+	// Channels follow Spring instead of the eased alpha, and the tween ends when they settle
+	bool bIsSpring = false;
+	// A settled spring kept alive for retargeting, it isn't evaluated until then
+	bool bIsSleeping = false;
+	bool bKeepAliveWhenSettled = false;
+
+	// Rebased by a retarget, the channels add VelocityWeight times whatever of their Velocities the eased
+	// lerp doesn't start with, EaseStartSlope being its speed per unit of distance. The new curve keeps the
+	// easing and leaves at the speed the old one had. See FBUITweenStorage::Rebase()
+	bool bCarriesVelocity = false;
+	float VelocityWeight = 0;
+	float EaseStartSlope = 0;
+
+	// Index into FBUITweenStorage's springs while bIsSpring, so the other tweens don't carry the state
+	int32 SpringIndex = INDEX_NONE;
+
+	// Index into each channel's entries, only meaningful if the channel bit is set in ChannelMask
+	int32 ChannelIndices[ static_cast<int32>( EBUITweenChannel::Num ) ];
+
+	// Where the easing is in the current cycle, which runs backwards on the way back of a ping-pong
+	inline float GetCycleTime() const
+	{
+		return bIsReversed ? Duration - Alpha : Alpha;
+	}
+
+	inline bool HasChannel( EBUITweenChannel Channel ) const
+	{
+		return ( ChannelMask & ( 1 << static_cast<uint16>( Channel ) ) ) != 0;
+	}
+
+	// Entries this tween has in the channel, starting at its channel index
+	inline int32 NumEntries( EBUITweenChannel Channel ) const
+	{
+		if ( !HasChannel( Channel ) )
+		{
+			return 0;
+		}
+		switch ( Channel )
+		{
+			case EBUITweenChannel::MaterialParameter: return NumMaterialParams;
+			case EBUITweenChannel::Property: return NumProperties;
+			default: return 1;
+		}
+	}
+};
+
+class FBUITweenChannelBase
+{
+public:
+	virtual ~FBUITweenChannelBase() { }
+
+	virtual int32 Num() const = 0;
+	// Returns the owner of the entry that was swapped into Index, or INDEX_NONE
+	virtual int32 RemoveAtSwap( int32 Index ) = 0;
+	virtual void SetOwner( int32 Index, int32 Owner ) = 0;
+	virtual void Empty() = 0;
+	virtual void Reserve( int32 Number ) = 0;
+	virtual SIZE_T GetAllocatedSize() const = 0;
+};
+
+template<typename T>
+class TBUITweenChannel : public FBUITweenChannelBase
+{
+public:
+	struct FEntry
+	{
+		int32 Owner;
+		T StartValue;
+		T TargetValue;
+		T CurrentValue;
+		// Set by the evaluate phase when CurrentValue moved this frame
+		bool bIsDirty;
+	};
+
+	TArray< FEntry > Entries;
+	// Only used by springs and retargeted tweens, kept beside Entries so other tweens don't carry it through
+	// the evaluate. For springs StartValue is the spring's position rather than where it started.
+	TArray< T > Velocities;
+	// Null for everything but keyframed entries. The keys stay in the instance's prop, whose slot outlives
+	// the entry and never moves.
+	TArray< TBUITweenKeyCursor<T> > KeyCursors;
+
+	template<typename PropType>
+	int32 Add( int32 Owner, const PropType& Prop, const TBUITweenKeys<T>* pKeys = nullptr )
+	{
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Owner = Owner;
+		Entry.StartValue = Prop.StartValue;
+		// A tween with only a From value holds still rather than lerping to garbage. With keys the target is
+		// the last one, which Begin() already set.
+		Entry.TargetValue = Prop.bHasTarget || pKeys ? Prop.TargetValue : Prop.StartValue;
+		Entry.CurrentValue = Prop.CurrentValue;
+		Entry.bIsDirty = false;
+		Velocities.AddZeroed();
+		KeyCursors.Add( TBUITweenKeyCursor<T>{ pKeys, 0 } );
+		return Entries.Num() - 1;
+	}
+
+	virtual int32 Num() const override
+	{
+		return Entries.Num();
+	}
+	virtual int32 RemoveAtSwap( int32 Index ) override
+	{
+		Entries.RemoveAtSwap( Index, 1, false );
+		Velocities.RemoveAtSwap( Index, 1, false );
+		KeyCursors.RemoveAtSwap( Index, 1, false );
+		return Entries.IsValidIndex( Index ) ? Entries[ Index ].Owner : INDEX_NONE;
+	}
+	virtual void SetOwner( int32 Index, int32 Owner ) override
+	{
+		Entries[ Index ].Owner = Owner;
+	}
+	virtual void Empty() override
+	{
+		Entries.Empty();
+		Velocities.Empty();
+		KeyCursors.Empty();
+	}
+	virtual void Reserve( int32 Number ) override
+	{
+		Entries.Reserve( Number );
+		Velocities.Reserve( Number );
+		KeyCursors.Reserve( Number );
+	}
+	virtual SIZE_T GetAllocatedSize() const override
+	{
+		return Entries.GetAllocatedSize() + Velocities.GetAllocatedSize() + KeyCursors.GetAllocatedSize();
+	}
+};
+
+// A channel a tween can have several entries in, as a run of FBUITweenHeader::NumEntries() starting at its
+// channel index. Removing a tween only marks its run dead, the dead entries are squeezed out once at the
+// start of the next update so the runs stay contiguous. BindingType is what the apply phase needs to write
+// an entry, kept beside the values like the velocities.
+template<typename T, typename BindingType, EBUITweenChannel ChannelType>
+class TBUITweenRunChannel : public TBUITweenChannel<T>
+{
+public:
+	TArray< BindingType > Bindings;
+	int32 NumDead = 0;
+
+	template<typename PropType>
+	int32 Add( int32 Owner, const PropType& Prop, const BindingType& Binding )
+	{
+		Bindings.Add( Binding );
+		return TBUITweenChannel<T>::Add( Owner, Prop );
+	}
+
+	// Drops the dead entries and points every header at where its run moved to
+	void Compact( TArray< FBUITweenHeader >& Headers )
+	{
+		int32 NumAlive = 0;
+		for ( int32 i = 0; i < this->Entries.Num(); ++i )
+		{
+			const int32 Owner = this->Entries[ i ].Owner;
+			if ( Owner == INDEX_NONE )
+			{
+				continue;
+			}
+			if ( NumAlive == 0 || this->Entries[ NumAlive - 1 ].Owner != Owner )
+			{
+				Headers[ Owner ].ChannelIndices[ static_cast<int32>( ChannelType ) ] = NumAlive;
+			}
+			if ( i != NumAlive )
+			{
+				this->Entries[ NumAlive ] = this->Entries[ i ];
+				this->Velocities[ NumAlive ] = this->Velocities[ i ];
+				this->KeyCursors[ NumAlive ] = this->KeyCursors[ i ];
+				Bindings[ NumAlive ] = MoveTemp( Bindings[ i ] );
+			}
+			++NumAlive;
+		}
+		this->Entries.SetNum( NumAlive, false );
+		this->Velocities.SetNum( NumAlive, false );
+		this->KeyCursors.SetNum( NumAlive, false );
+		Bindings.SetNum( NumAlive, false );
+		NumDead = 0;
+	}
+
+	// Nothing moves, so the other runs stay where their headers expect them
+	virtual int32 RemoveAtSwap( int32 Index ) override
+	{
+		this->Entries[ Index ].Owner = INDEX_NONE;
+		++NumDead;
+		return INDEX_NONE;
+	}
+	virtual void Empty() override
+	{
+		TBUITweenChannel<T>::Empty();
+		Bindings.Empty();
+		NumDead = 0;
+	}
+	virtual void Reserve( int32 Number ) override
+	{
+		TBUITweenChannel<T>::Reserve( Number );
+		Bindings.Reserve( Number );
+	}
+	virtual SIZE_T GetAllocatedSize() const override
+	{
+		return TBUITweenChannel<T>::GetAllocatedSize() + Bindings.GetAllocatedSize();
+	}
+};
+
+struct FBUITweenMaterialBinding
+{
+	TWeakObjectPtr<UMaterialInstanceDynamic> pMaterial;
+	FName Name;
+	int32 ParameterIndex;
+	bool bIsVector;
+};
+
+// Scalars only use R, see FBUITweenMaterialParamProp
+using FBUITweenMaterialChannel = TBUITweenRunChannel< FLinearColor, FBUITweenMaterialBinding, EBUITweenChannel::MaterialParameter >;
+using FBUITweenPropertyChannel = TBUITweenRunChannel< FVector4, FBUITweenPropertyBinding, EBUITweenChannel::Property >;
+
+enum class EBUITweenSlotState : uint8
+{
+	Free,
+	// Created but not yet added to the headers, that happens at the end of the next update
+	Pending,
+	Active,
+	// Removed from the headers, waiting for its complete callbacks to run
+	Completing,
+};
+
+struct FBUITweenSlot
+{
+	FBUITweenInstance Instance;
+	// Only set for sequences, Instance then carries the sequence's delay and callbacks
+	TUniquePtr<FBUITweenSequence> Sequence;
+	// Only set for staggered groups, Instance then is the configuration shared by every element
+	TUniquePtr<FBUITweenStagger> Stagger;
+	// Kept separately from the instance's weak pointer so the index can still be cleaned up after the widget dies
+	FObjectKey WidgetKey;
+	// The same for Slate tweens, only used as a key
+	const SWidget* SlateWidgetKey = nullptr;
+	uint32 Generation = 1;
+	int32 HeaderIndex = INDEX_NONE;
+	EBUITweenSlotState State = EBUITweenSlotState::Free;
+};
+
+// Properties written together at the end of the apply phase, for a widget driven by several tweens at once
+// or by sequence steps and staggered elements
+struct FBUITweenWidgetWrite
+{
+	UWidget* pWidget = nullptr;
+	FWidgetTransform Transform;
+	FLinearColor Color;
+	// Set when Color needs writing, all tweens on a widget resolve the same color target
+	const FBUITweenTargets* pColorTargets = nullptr;
+	float Opacity = 1;
+	bool bHasTransform = false;
+	bool bHasOpacity = false;
+};
+
+// Setter calls the apply phase could have made, and the ones it actually made. The difference is
+// the widget invalidations avoided by skipping unchanged values and coalescing writes per widget.
+struct FBUITweenApplyStats
+{
+	int64 NumRequested = 0;
+	int64 NumWrites = 0;
+	// Running tweens whose widget was hidden, none of their writes are requested
+	int64 NumCulled = 0;
+
+	int64 NumAvoided() const { return NumRequested - NumWrites; }
+};
+
+// Structure-of-arrays storage for tweens.
+// Headers hold the per-tween timing and each property lives in its own dense channel array. The cold
+// data (delegates, builder state) sits in a slot pool whose addresses never move, which is what
+// FBUITweenHandle indexes into.
+class BUITWEEN_API FBUITweenStorage
+{
+public:
+	FBUITweenStorage();
+	~FBUITweenStorage();
+
+	// Handles and the registry point at the storage, so it never moves
+	FBUITweenStorage( const FBUITweenStorage& ) = delete;
+	FBUITweenStorage& operator=( const FBUITweenStorage& ) = delete;
+
+	// Ids are never reused, so a handle outliving its storage resolves to nothing. Empty() moves the
+	// storage to a new id for the same reason.
+	uint32 GetId() const { return Id; }
+	static FBUITweenStorage* FindById( uint32 InId );
+	// Every live storage, the global one and one per world
+	static const TMap< uint32, FBUITweenStorage* >& GetAll();
+
+	FBUITweenInstance& Create( UWidget* pInWidget, float InDuration, float InDelay );
+	FBUITweenInstance& CreateSlate( const TSharedRef<SWidget>& InWidget, float InDuration, float InDelay );
+	FBUITweenSequence& CreateSequence( float InDelay );
+	FBUITweenInstance& CreateStaggered( TArrayView<UWidget* const> InWidgets, float InDuration, float InStaggerInterval, float InDelay );
+	void Update( float DeltaTime );
+	// Finishes every begun tween in one update, firing their callbacks
+	void CompleteAll();
+
+	// Start, loop and complete callbacks are queued during the update and fired at its end, native ones
+	// first and then the Blueprint delegates. Deferred, they wait for DispatchEvents() instead.
+	void SetDeferEvents( bool bInDeferEvents ) { bDeferEvents = bInDeferEvents; }
+	void DispatchEvents();
+	bool HasEvents() const { return Events.Num() > 0; }
+
+	int32 Clear( UWidget* pInWidget );
+	int32 Clear( const TSharedRef<SWidget>& InWidget );
+	bool Contains( UWidget* pInWidget ) const;
+	void Empty();
+
+	// Preallocates everything an update touches for Number tweens, so up to that many running and
+	// being created or completed each frame never reach the allocator. Nothing is ever shrunk after.
+	void Reserve( int32 Number );
+
+	// The tween while it can still be set up, nullptr once its first update has copied it into the header
+	FBUITweenInstance* Find( const FBUITweenHandle& Handle );
+	bool IsPending( const FBUITweenHandle& Handle ) const;
+	// A tween running or pending on the widget, meant for widgets with a single tween like a hover effect
+	FBUITweenHandle FindHandle( UWidget* pInWidget ) const;
+	bool IsTweening( const FBUITweenHandle& Handle ) const;
+	bool SetPaused( const FBUITweenHandle& Handle, bool bInIsPaused );
+	bool Cancel( const FBUITweenHandle& Handle );
+
+	int32 Num() const { return Headers.Num(); }
+	int32 NumPending() const { return PendingHandles.Num(); }
+
+	// Heap memory used by the headers, the channel arrays and everything else (slots, indices, scratch)
+	SIZE_T GetHeaderAllocatedSize() const;
+	SIZE_T GetChannelAllocatedSize() const;
+	SIZE_T GetInstanceAllocatedSize() const;
+
+	// The last update's apply phase, and every one since the storage was created
+	const FBUITweenApplyStats& GetApplyStats() const { return ApplyStats; }
+	const FBUITweenApplyStats& GetTotalApplyStats() const { return TotalApplyStats; }
+
+protected:
+	friend class FBUITweenRetarget;
+	friend class FBUITweenSequence;
+	friend class FBUITweenStagger;
+
+	// Restarts a running duration tween from its current values and velocities, its props then each get
+	// a new target. Springs, which already keep their velocity, are left as they are.
+	bool Rebase( const FBUITweenHandle& Handle );
+	bool SetDuration( const FBUITweenHandle& Handle, float InDuration );
+	bool SetEasing( const FBUITweenHandle& Handle, EBUIEasingType InType, TOptional<float> InEasingParam );
+
+	// Moves one prop's target on a live tween, see FBUITweenRetarget
+	template<typename T, typename PropType>
+	bool RetargetChannel( const FBUITweenHandle& Handle, EBUITweenChannel Channel, TBUITweenChannel<T>& Storage, PropType FBUITweenInstance::* Prop, const T& InTarget );
+
+	FBUITweenChannelBase& GetChannel( EBUITweenChannel Channel );
+	const FBUITweenChannelBase& GetChannel( EBUITweenChannel Channel ) const
+	{
+		return const_cast<FBUITweenStorage*>( this )->GetChannel( Channel );
+	}
+
+	FBUITweenSlot* GetSlot( const FBUITweenHandle& Handle );
+	const FBUITweenSlot* GetSlot( const FBUITweenHandle& Handle ) const;
+	// Resolved at Begin() and left in the instance, only the color and slot channels need it
+	FBUITweenTargets& GetTargets( const FBUITweenHeader& Header ) { return Slots[ Header.SlotIndex ].Instance.Targets; }
+	int32 AllocateSlot();
+	void FreeSlot( int32 SlotIndex );
+
+	void Activate( int32 SlotIndex );
+	void ActivatePending();
+	void CancelActive( int32 HeaderIndex );
+	// Takes a copy, freeing the slots edits the index the list came from. Staggered groups in the list only
+	// stop their element for WidgetKey.
+	int32 ClearSlots( const TArray< int32, TInlineAllocator<2> > SlotIndices, const FObjectKey& WidgetKey = FObjectKey() );
+	void RemoveFromWidgetIndex( const FObjectKey& WidgetKey, int32 SlotIndex );
+	void RemoveAtSwap( int32 Index );
+	void QueueEvent( int32 SlotIndex, EBUITweenEvent Type );
+	// A step index targets that step of the sequence in the handle's slot rather than the slot's own tween
+	void QueueEvent( const FBUITweenHandle& Handle, EBUITweenEvent Type, int32 StepIndex = INDEX_NONE );
+
+	// Pure math over the headers and channels, no UObject access so it runs across worker threads
+	void Evaluate( float DeltaTime );
+	void EvaluateHeader( FBUITweenHeader& Header, float DeltaTime );
+	void EvaluateEasing( bool bForceSingleThread );
+	template<typename T>
+	void EvaluateChannel( TBUITweenChannel<T>& Channel, float Epsilon, int32 Start, int32 End ) const;
+	void EvaluateVisibility( int32 Start, int32 End );
+
+	// Snaps the springs that came within the epsilons of their targets, and completes or puts them to sleep
+	void SettleSprings();
+	template<typename T>
+	bool SettleSpringChannel( TBUITweenChannel<T>& Channel, const FBUITweenHeader& Header, EBUITweenChannel ChannelType, float Epsilon );
+
+	// Flags running tweens whose widget isn't rendered, for the ones that opted in. Each ancestor is checked
+	// once per frame however many tweens sit under it, and each ScrollBox arranges its children once for all
+	// the tweens inside it.
+	void Cull();
+	void SetCulled( FBUITweenHeader& Header, bool bInIsCulled );
+
+	// Pushes the evaluated values into UMG on the game thread
+	void Apply();
+	// Slate tweens write their transform and opacity straight to the SWidget, from the header pass
+	void ApplySlate( FBUITweenHeader& Header, SWidget& InWidget );
+
+	FBUITweenWidgetWrite& FindOrAddWidgetWrite( UWidget* pWidget );
+	void RefreshSharesWidget( const FObjectKey& WidgetKey );
+
+	TArray< FBUITweenHeader > Headers;
+	TArray< FBUITweenSpringState > Springs;
+
+	TBUITweenChannel<FVector2D> TranslationChannel;
+	TBUITweenChannel<FVector2D> ScaleChannel;
+	TBUITweenChannel<float> RotationChannel;
+	TBUITweenChannel<float> OpacityChannel;
+	TBUITweenChannel<FLinearColor> ColorChannel;
+	TBUITweenChannel<ESlateVisibility> VisibilityChannel;
+	TBUITweenChannel<FVector2D> CanvasPositionChannel;
+	TBUITweenChannel<FVector4> PaddingChannel;
+	TBUITweenChannel<float> MaxDesiredHeightChannel;
+	FBUITweenMaterialChannel MaterialParameterChannel;
+	FBUITweenPropertyChannel PropertyChannel;
+
+	TChunkedArray< FBUITweenSlot > Slots;
+	TArray< int32 > FreeSlots;
+
+	// Every slot in use per widget, so Clear and Contains don't need to scan the headers
+	TMap< FObjectKey, TArray< int32, TInlineAllocator<2> > > WidgetSlots;
+	TMap< const SWidget*, TArray< int32, TInlineAllocator<2> > > SlateWidgetSlots;
+
+	// We delay adding until the end of an update so we don't add to Headers within our update loop
+	TArray< FBUITweenHandle > PendingHandles;
+
+	struct FChannelWork
+	{
+		EBUITweenChannel Channel;
+		int32 Start;
+		int32 End;
+	};
+	TArray< FChannelWork > ChannelWork;
+
+	// Running headers grouped by easing type, gathered into contiguous arrays for FBUIEasing::EaseBatch
+	struct FEaseWork
+	{
+		EBUIEasingType Type;
+		int32 Start;
+		int32 End;
+	};
+	TArray< FEaseWork > EaseWork;
+	TArray< int32 > EaseHeaderIndices;
+	TArray< float > EaseTimes;
+	TArray< float > EaseDurations;
+	TArray< float > EaseParams;
+	TArray< float > EaseValues;
+	// Only filled when FBUIEasingLUT is enabled, null samples are evaluated analytically
+	TArray< const FBUIEasingTable* > EaseTables;
+
+	TArray< FBUITweenWidgetWrite > WidgetWrites;
+	TMap< UWidget*, int32 > WidgetWriteIndices;
+
+	// Culled tweens inside a ScrollBox, checked against its arranged children once the headers are done
+	struct FScrollCheck
+	{
+		int32 HeaderIndex;
+		class UScrollBox* pScrollBox;
+		TSharedRef<SWidget> Widget;
+	};
+	TArray< FScrollCheck > ScrollChecks;
+
+	// Whether a widget or anything above it is hidden, filled in by IsHiddenInHierarchy for the frame's cull
+	struct FHiddenCheck
+	{
+		bool bIsHidden;
+		// Nearest ScrollBox above the widget that could still scroll it out of view
+		class UScrollBox* pScrollBox;
+	};
+	TMap< UWidget*, FHiddenCheck > HiddenChecks;
+	TArray< UWidget* > AncestorChain;
+	bool IsHiddenInHierarchy( UWidget* pWidget, bool bCheckVisibility, bool bCheckOpacity, class UScrollBox*& OutScrollBox );
+	FHiddenCheck CheckAncestors( UWidget* pWidget );
+	TSet< TSharedRef<SWidget> > WidgetsToFind;
+	TMap< TSharedRef<SWidget>, FArrangedWidget > FoundGeometries;
+
+	FBUITweenApplyStats ApplyStats;
+	FBUITweenApplyStats TotalApplyStats;
+
+	// Keyed by handle rather than header index, the headers get removed and swapped before dispatch.
+	// Completed slots stay allocated until their event has been dispatched.
+	struct FEvent
+	{
+		FBUITweenHandle Handle;
+		int32 StepIndex;
+		EBUITweenEvent Type;
+		bool bHasFired;
+	};
+	FBUITweenInstance* FindEventInstance( const FEvent& Event );
+	TArray< FEvent > Events;
+	// Swapped with Events while dispatching, so callbacks can queue more without reallocating either
+	TArray< FEvent > DispatchingEvents;
+
+	// Cancelling during an update only flags tweens, they are removed once iteration is done
+	bool bIsUpdating = false;
+	bool bIsDispatching = false;
+	bool bDeferEvents = false;
+
+	uint32 Id = 0;
+};
+
+
+template<typename T, typename PropType>
+bool FBUITweenStorage::RetargetChannel( const FBUITweenHandle& Handle, EBUITweenChannel Channel, TBUITweenChannel<T>& Storage, PropType FBUITweenInstance::* Prop, const T& InTarget )
+{
+	FBUITweenSlot* Slot = GetSlot( Handle );
+	if ( !Slot || Slot->State == EBUITweenSlotState::Completing || !( Slot->Instance.*Prop ).IsSet() )
+	{
+		return false;
+	}
+
+	// A tween that hasn't been added to the headers yet picks the new target up from its instance, where it
+	// replaces the keys. An active tween's channel entry may still point at them, so they stay there.
+	( Slot->Instance.*Prop ).SetTarget( InTarget );
+	if ( Slot->State != EBUITweenSlotState::Active )
+	{
+		( Slot->Instance.*Prop ).Keys.Reset();
+		return true;
+	}
+
+	FBUITweenHeader& Header = Headers[ Slot->HeaderIndex ];
+	if ( Header.bIsComplete || Header.bIsGroup || !Header.HasChannel( Channel ) )
+	{
+		return false;
+	}
+
+	// A spring carries on from its position and velocity and a duration tween has been rebased to where it
+	// is by now, so in both cases only the end point moves and replaces the keys
+	const int32 Index = Header.ChannelIndices[ static_cast<int32>( Channel ) ];
+	Storage.Entries[ Index ].TargetValue = InTarget;
+	Storage.KeyCursors[ Index ].pKeys = nullptr;
+	Header.bIsSleeping = false;
+	return true;
+}
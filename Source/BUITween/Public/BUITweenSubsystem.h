@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "BUITweenStorage.h"
+#include "BUITweenGroup.h"
+#include "BUITweenSubsystem.generated.h"
+
+// Owns and ticks the tweens of one world, so PIE instances and test worlds only pay for their own
+// tweens and tearing a world down frees all of its tweens at once. UBUITween routes to it through the
+// widget's world, widgets without one use UBUITween's global storage.
+// Tweens are split into named groups, each with its own storage, time scale, pause state and tick
+// phase. Tweens not created in a group are in the NAME_None group.
+UCLASS()
+class BUITWEEN_API UBUITweenSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UBUITweenSubsystem* Get( const UObject* WorldContextObject );
+
+	FBUITweenStorage& GetStorage( FName InGroup = NAME_None );
+
+	// Adds the group if needed, its running tweens keep going under the new settings
+	void ConfigureGroup( FName InGroup, const FBUITweenGroupSettings& InSettings );
+	const FBUITweenGroupSettings* GetGroupSettings( FName InGroup ) const;
+
+	// A paused group isn't updated at all, whatever number of tweens it has
+	void SetGroupPaused( FName InGroup, bool bInIsPaused );
+	bool IsGroupPaused( FName InGroup ) const;
+	void SetGroupTimeScale( FName InGroup, float InTimeScale );
+
+	// A widget can have tweens in several groups, these check all of them
+	int32 Clear( UWidget* pInWidget );
+	bool Contains( UWidget* pInWidget ) const;
+	FBUITweenHandle FindHandle( UWidget* pInWidget ) const;
+
+	// USubsystem interface
+	virtual void Initialize( FSubsystemCollectionBase& Collection ) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick( float DeltaTime ) override;
+	virtual TStatId GetStatId() const override
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT( UBUITweenSubsystem, STATGROUP_Tickables );
+	}
+	// UI keeps animating in pause menus, each group decides whether it stops with the game
+	virtual bool IsTickableWhenPaused() const override
+	{
+		return true;
+	}
+
+protected:
+	virtual bool DoesSupportWorldType( const EWorldType::Type WorldType ) const override;
+
+	struct FGroup
+	{
+		FName Name;
+		FBUITweenGroupSettings Settings;
+		bool bIsPaused = false;
+		// Held by pointer since a storage never moves
+		TUniquePtr<FBUITweenStorage> Storage;
+	};
+
+	FGroup* FindGroup( FName InGroup );
+	const FGroup* FindGroup( FName InGroup ) const;
+	FGroup& FindOrAddGroup( FName InGroup );
+	void UpdatePhase( EBUITweenTickPhase Phase );
+
+	void OnWorldPreActorTick( UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds );
+	void OnWorldPostActorTick( UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds );
+
+	// Only a handful per world so a search is cheap, and unlike a map it can grow while being iterated by
+	// index, when a callback creates a tween in a new group
+	TArray< FGroup > Groups;
+
+	FDelegateHandle PreActorTickHandle;
+	FDelegateHandle PostActorTickHandle;
+};
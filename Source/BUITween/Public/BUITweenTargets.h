@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "Slate/WidgetTransform.h"
+
+class UMaterialInstanceDynamic;
+
+enum class EBUITweenColorTarget : uint8
+{
+	None,
+	UserWidget,
+	Image,
+	Border,
+};
+
+enum class EBUITweenSlotTarget : uint8
+{
+	None,
+	CanvasPanel,
+	Overlay,
+	HorizontalBox,
+	VerticalBox,
+};
+
+// The concrete widget and slot types a tween writes to, resolved once at Begin() so applying a value
+// is a switch instead of a chain of casts
+struct BUITWEEN_API FBUITweenTargets
+{
+public:
+	void Resolve( UWidget* pWidget );
+
+	bool GetColor( UWidget* pWidget, FLinearColor& OutColor ) const;
+	bool GetCanvasPosition( UWidget* pWidget, FVector2D& OutPosition );
+	bool GetPadding( UWidget* pWidget, FMargin& OutPadding );
+	bool GetMaxDesiredHeight( UWidget* pWidget, float& OutHeight ) const;
+
+	void SetColor( UWidget* pWidget, const FLinearColor& InColor ) const;
+	void SetCanvasPosition( UWidget* pWidget, const FVector2D& InPosition );
+	void SetPadding( UWidget* pWidget, const FMargin& InPadding );
+	void SetMaxDesiredHeight( UWidget* pWidget, float InHeight ) const;
+
+	// The brush material of an image or border as a dynamic instance, creating it the first time
+	UMaterialInstanceDynamic* GetDynamicMaterial( UWidget* pWidget ) const;
+	// Writes through the parameter's index, which is looked up again by name if it went stale. Scalars use R
+	static void SetMaterialParameter( UMaterialInstanceDynamic* pMaterial, FName InName, bool bIsVector, int32& InOutParameterIndex, const FLinearColor& InValue );
+
+	// A plain SWidget only keeps the composed render transform, so it's split back into translation, scale
+	// and angle. Shear isn't kept.
+	static FWidgetTransform GetSlateRenderTransform( const SWidget& InWidget );
+	static void SetSlateRenderTransform( SWidget& InWidget, const FWidgetTransform& InTransform );
+
+protected:
+	// Returns the widget's slot, re-resolving the slot type if it was re-parented since Begin()
+	UPanelSlot* GetSlot( UWidget* pWidget );
+	void ResolveSlot( UPanelSlot* pInSlot );
+
+	TWeakObjectPtr<UPanelSlot> pSlot;
+	EBUITweenColorTarget ColorTarget = EBUITweenColorTarget::None;
+	EBUITweenSlotTarget SlotTarget = EBUITweenSlotTarget::None;
+	bool bIsSizeBox = false;
+};